@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_server.hpp"
+#include "timings_reports.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <semaphore>
+#include <string>
+#include <vector>
+
+// Scaling sweep of the client: state.threads() threads, each one keeping state.range(0) requests in flight (blocking infer
+// calls when 1, infer_async callbacks otherwise) of state.range(1) bytes, returned as is by the echo model.
+// - shared: all the threads share one client
+// - per_thread: every thread creates its own client, and then its own channel
+// Each point reports the throughput (items_per_second) and the p50/p90/p99/p99.9/p99.99 latencies (microseconds) of the requests of all the threads.
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+enum class client_mode
+{
+    shared,
+    per_thread
+};
+
+constexpr std::chrono::milliseconds infer_timeout = std::chrono::seconds(10);
+
+// Latencies of all the threads of the running benchmark, the last thread leaving the loop reports their percentiles
+struct latency_samples
+{
+    std::mutex mutex;
+    timings::latency_histogram histogram;
+    int merged_threads = 0;
+};
+
+latency_samples& samples()
+{
+    static latency_samples latency_samples;
+    return latency_samples;
+}
+
+void report_latencies(benchmark::State& state, const timings::latency_histogram& thread_histogram)
+{
+    latency_samples& latency_samples = samples();
+    std::lock_guard lock(latency_samples.mutex);
+    latency_samples.histogram.merge(thread_histogram);
+    if (++latency_samples.merged_threads < state.threads())
+        return;
+
+    // Counters are summed across the threads: only the last one sets them
+    for (auto&& [percentile_name, percentile] : timings::reported_percentiles)
+    {
+        state.counters[std::string(percentile_name) + "_us"] = static_cast<double>(latency_samples.histogram.percentile(percentile)) / 1000.0;
+    }
+
+    latency_samples.histogram.reset();
+    latency_samples.merged_threads = 0;
+}
+
+tc::infer::async_client_interface* shared_client()
+{
+    static std::mutex client_mutex;
+    static std::unique_ptr<tc::infer::async_client_interface> client;
+
+    std::lock_guard lock(client_mutex);
+    if (!client)
+        client = benchmarks::create_async_client();
+
+    return client.get();
+}
+
+}
+
+static void benchmark_concurrency_sweep(benchmark::State& state, client_mode mode)
+{
+    std::unique_ptr<tc::infer::async_client_interface> thread_client;
+    tc::infer::async_client_interface* client = nullptr;
+    if (mode == client_mode::shared)
+    {
+        client = shared_client();
+    }
+    else
+    {
+        thread_client = benchmarks::create_async_client();
+        client = thread_client.get();
+    }
+
+    const auto in_flight = static_cast<std::ptrdiff_t>(state.range(0));
+    const auto elements = static_cast<size_t>(state.range(1)) / sizeof(float);
+
+    std::vector<float> data(elements, 1.0f);
+    tc::infer::infer_request request;
+    request.model_name = "echo";
+    request.model_version = "1";
+    request.add_input_tensor(data.data(), data.size(), { 1, static_cast<int64_t>(elements) }, "INPUT0");
+
+    std::mutex latencies_mutex;
+    timings::latency_histogram latencies;
+    std::atomic<bool> failed = false;
+
+    if (in_flight == 1)
+    {
+        for (auto _ : state)
+        {
+            const auto start = clock_type::now();
+            const tc::infer::infer_response response = client->infer(request, infer_timeout);
+            latencies.record(clock_type::now() - start);
+
+            if (response.output_tensors.size() != 1)
+                failed = true;
+        }
+    }
+    else
+    {
+        std::counting_semaphore<> slots(in_flight);
+        for (auto _ : state)
+        {
+            slots.acquire();
+            const auto start = clock_type::now();
+            client->infer_async(
+                request,
+                [&, start](tc::infer::infer_response response, std::exception_ptr error)
+                {
+                    const auto latency = clock_type::now() - start;
+                    {
+                        std::lock_guard lock(latencies_mutex);
+                        latencies.record(latency);
+                    }
+
+                    if (error || response.output_tensors.size() != 1)
+                        failed = true;
+
+                    slots.release();
+                },
+                infer_timeout);
+        }
+
+        // Wait for the requests still in flight
+        for (std::ptrdiff_t i = 0; i < in_flight; ++i)
+        {
+            slots.acquire();
+        }
+    }
+
+    if (failed)
+        state.SkipWithError("infer failed");
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+    report_latencies(state, latencies);
+}
+
+static void sweep_arguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({ "in_flight", "bytes" })
+        ->ArgsProduct({ { 1, 4, 16 }, { 64, 4 << 10, 256 << 10 } })
+        ->ThreadRange(1, 64)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_CAPTURE(benchmark_concurrency_sweep, shared, client_mode::shared)->Apply(sweep_arguments);
+BENCHMARK_CAPTURE(benchmark_concurrency_sweep, per_thread, client_mode::per_thread)->Apply(sweep_arguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <teiacare/inference_client/data_type.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The std::map lookups data_type used before the constexpr registry, kept as the baseline
+const std::map<std::string, tc::infer::data_type::value> map_to_type
+{
+    { "BOOL", tc::infer::data_type::Bool }, { "UINT8", tc::infer::data_type::Uint8 }, { "UINT16", tc::infer::data_type::Uint16 },
+    { "UINT32", tc::infer::data_type::Uint32 }, { "UINT64", tc::infer::data_type::Uint64 }, { "INT8", tc::infer::data_type::Int8 },
+    { "INT16", tc::infer::data_type::Int16 }, { "INT32", tc::infer::data_type::Int32 }, { "INT64", tc::infer::data_type::Int64 },
+    { "FP16", tc::infer::data_type::Fp16 }, { "BF16", tc::infer::data_type::Bf16 }, { "FP32", tc::infer::data_type::Fp32 },
+    { "FP64", tc::infer::data_type::Fp64 }, { "BYTES", tc::infer::data_type::String }, { "Unknown", tc::infer::data_type::Unknown }
+};
+
+const std::map<tc::infer::data_type::value, std::string> map_to_string = []
+{
+    std::map<tc::infer::data_type::value, std::string> to_string;
+    for (auto&& [name, type] : map_to_type)
+    {
+        to_string[type] = name;
+    }
+    return to_string;
+}();
+
+const std::vector<std::string> wire_names { "FP32", "INT64", "UINT8", "BYTES", "FP16", "INT32", "BOOL", "UINT16" };
+
+}
+
+// Parsing of the data type of every response output
+template<bool registry>
+static void benchmark_data_type_parse(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (const std::string& name : wire_names)
+        {
+            if constexpr (registry)
+                benchmark::DoNotOptimize(tc::infer::data_type::from_string(name));
+            else
+                benchmark::DoNotOptimize(map_to_type.find(name)->second);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(wire_names.size()));
+}
+
+// Name of the data type of every request input, set on the ModelInferRequest
+template<bool registry>
+static void benchmark_data_type_name(benchmark::State& state)
+{
+    std::string datatype;
+    for (auto _ : state)
+    {
+        for (int type = tc::infer::data_type::Bool; type < tc::infer::data_type::Unknown; ++type)
+        {
+            const auto value = static_cast<tc::infer::data_type::value>(type);
+            if constexpr (registry)
+            {
+                const std::string_view name = tc::infer::data_type(value).name();
+                datatype.assign(name.data(), name.size());
+            }
+            else
+            {
+                datatype = std::string(map_to_string.at(value));
+            }
+            benchmark::DoNotOptimize(datatype.data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * tc::infer::data_type::Unknown);
+}
+
+BENCHMARK(benchmark_data_type_parse<false>)->Name("data_type_parse/map");
+BENCHMARK(benchmark_data_type_parse<true>)->Name("data_type_parse/registry");
+BENCHMARK(benchmark_data_type_name<false>)->Name("data_type_name/map");
+BENCHMARK(benchmark_data_type_name<true>)->Name("data_type_name/registry");
+
+BENCHMARK_MAIN();
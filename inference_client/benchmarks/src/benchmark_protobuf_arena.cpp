@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+#include "protobuf_arena.hpp"
+#include "tensor_converter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+static std::atomic<int64_t> allocations = 0;
+
+// Counts the plain, array and aligned allocations: the default nothrow and sized forms forward to these ones
+static void* counted_alloc(size_t size, size_t alignment = alignof(std::max_align_t))
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+        ptr = std::malloc(size ? size : 1);
+    else
+        ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+
+    if (ptr)
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size)
+{
+    return counted_alloc(size);
+}
+
+void* operator new[](size_t size)
+{
+    return counted_alloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+// Request and response of the simple_int32 model: two 1x16 INT32 inputs, two 1x16 INT32 outputs
+static tc::infer::infer_request make_request()
+{
+    std::vector<int32_t> data(16, 1);
+
+    tc::infer::infer_request request;
+    request.model_name = "simple_int32";
+    request.model_version = "1";
+    request.add_input_tensor(data.data(), data.size(), { 1, 16 }, "INPUT0");
+    request.add_input_tensor(data.data(), data.size(), { 1, 16 }, "INPUT1");
+    return request;
+}
+
+static std::string make_response_wire()
+{
+    std::vector<int32_t> data(16, 2);
+
+    inference::ModelInferResponse response;
+    response.set_model_name("simple_int32");
+    response.set_model_version("1");
+    for (const char* name : { "OUTPUT0", "OUTPUT1" })
+    {
+        auto* output = response.add_outputs();
+        output->set_name(name);
+        output->set_datatype("INT32");
+        output->add_shape(1);
+        output->add_shape(16);
+        response.add_raw_output_contents(data.data(), data.size() * sizeof(int32_t));
+    }
+    return response.SerializeAsString();
+}
+
+// Client side of one infer call (request conversion and serialization, response parsing and conversion) without the transport
+template<bool use_arena>
+static void benchmark_infer_messages(benchmark::State& state)
+{
+    const auto infer_request = make_request();
+    const auto response_wire = make_response_wire();
+    const tc::infer::tensor_converter converter;
+
+    std::string request_wire;
+    const int64_t allocations_start = allocations.load();
+    for (auto _ : state)
+    {
+        if constexpr (use_arena)
+        {
+            tc::infer::thread_arena_scope arena_scope;
+            converter.get_infer_request(infer_request, arena_scope.arena())->SerializeToString(&request_wire);
+
+            auto response = tc::infer::make_arena_message<inference::ModelInferResponse>();
+            response->ParseFromString(response_wire);
+            benchmark::DoNotOptimize(converter.get_infer_response(response));
+        }
+        else
+        {
+            converter.get_infer_request(infer_request).SerializeToString(&request_wire);
+
+            auto response = std::make_shared<inference::ModelInferResponse>();
+            response->ParseFromString(response_wire);
+            benchmark::DoNotOptimize(converter.get_infer_response(response));
+        }
+    }
+
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocations.load() - allocations_start), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(benchmark_infer_messages<false>)->Name("infer_messages/heap")->Unit(benchmark::kMicrosecond);
+BENCHMARK(benchmark_infer_messages<true>)->Name("infer_messages/arena")->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <teiacare/inference_client/client_factory.hpp>
+#include <teiacare/inference_client/mock_server.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace benchmarks
+{
+// Server of the TC_INFER_SERVER_URI environment variable (e.g. "localhost:8001" for a Triton container started with
+// scripts/triton/triton_local_deploy.py), or an in-process mock server serving the same simple_int32 model
+inline const char* server_uri()
+{
+    return std::getenv("TC_INFER_SERVER_URI");
+}
+
+inline tc::infer::mock::mock_server& mock_server()
+{
+    static tc::infer::mock::mock_server server;
+    return server;
+}
+
+inline std::unique_ptr<tc::infer::client_interface> create_client(const tc::infer::client_options& options = {})
+{
+    if (const char* uri = server_uri())
+        return tc::infer::create_client(uri, options);
+
+    return mock_server().create_client(options);
+}
+
+inline std::unique_ptr<tc::infer::async_client_interface> create_async_client(const tc::infer::client_options& options = {})
+{
+    if (const char* uri = server_uri())
+        return tc::infer::create_async_client(uri, options);
+
+    return mock_server().create_async_client(options);
+}
+
+}
@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_server.hpp"
+
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+
+static void check_response(const tc::infer::infer_response& response, const std::vector<int32_t>& data_0, const std::vector<int32_t>& data_1)
+{
+    auto output0_data = response.output_tensors[0].as<int32_t>();
+    auto output1_data = response.output_tensors[1].as<int32_t>();
+    for (size_t i = 0; i < 16; ++i)
+    {
+        if ((data_0[i] + data_1[i]) != *(output0_data + i))
+            throw std::runtime_error("error: incorrect sum");
+
+        if ((data_0[i] - data_1[i]) != *(output1_data + i))
+            throw std::runtime_error("error: incorrect difference");
+    }
+}
+
+static void benchmark_teiacare_client(benchmark::State& state)
+{
+    auto client = benchmarks::create_client();
+
+    std::vector<int32_t> data_0 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::vector<int32_t> data_1 { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    std::vector<int64_t> shape { 1, 16 };
+
+    for (auto _ : state)
+    {
+        tc::infer::infer_request request;
+        request.model_name = "simple_int32";
+        request.model_version = "1";
+        request.add_input_tensor(data_0.data(), data_0.size(), shape, "INPUT0");
+        request.add_input_tensor(data_1.data(), data_1.size(), shape, "INPUT1");
+
+        tc::infer::infer_response response;
+        response = client->infer(request);
+
+        check_response(response, data_0, data_1);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Same requests of benchmark_teiacare_client sent over a single ModelStreamInfer stream,
+// keeping state.range(0) requests in flight
+static void benchmark_teiacare_client_stream(benchmark::State& state)
+{
+    auto client = benchmarks::create_client();
+    auto stream = client->create_infer_stream();
+    const size_t in_flight = static_cast<size_t>(state.range(0));
+
+    std::vector<int32_t> data_0 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::vector<int32_t> data_1 { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    std::vector<int64_t> shape { 1, 16 };
+
+    std::deque<std::future<tc::infer::infer_response>> pending;
+    for (auto _ : state)
+    {
+        tc::infer::infer_request request;
+        request.model_name = "simple_int32";
+        request.model_version = "1";
+        request.add_input_tensor(data_0.data(), data_0.size(), shape, "INPUT0");
+        request.add_input_tensor(data_1.data(), data_1.size(), shape, "INPUT1");
+
+        pending.push_back(stream->infer(request));
+        if (pending.size() < in_flight)
+            continue;
+
+        check_response(pending.front().get(), data_0, data_1);
+        pending.pop_front();
+    }
+
+    for (auto&& future : pending)
+    {
+        check_response(future.get(), data_0, data_1);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(benchmark_teiacare_client)
+    ->Threads(1)
+    ->Iterations(10'000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond)
+    ->ReportAggregatesOnly(false)
+    ->DisplayAggregatesOnly(false);
+
+// Concurrent batch-1 requests from many threads, coalesced by the client into batches of up to 8 rows
+static void benchmark_teiacare_client_batching(benchmark::State& state)
+{
+    static const auto client = benchmarks::create_client(tc::infer::client_options{ .dynamic_batching = true, .max_batch_size = 8 });
+
+    std::vector<int32_t> data_0 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::vector<int32_t> data_1 { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    std::vector<int64_t> shape { 1, 16 };
+
+    for (auto _ : state)
+    {
+        tc::infer::infer_request request;
+        request.model_name = "simple_int32";
+        request.model_version = "1";
+        request.add_input_tensor(data_0.data(), data_0.size(), shape, "INPUT0");
+        request.add_input_tensor(data_1.data(), data_1.size(), shape, "INPUT1");
+
+        check_response(client->infer(request), data_0, data_1);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(benchmark_teiacare_client_batching)
+    ->Threads(8)
+    ->Iterations(10'000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond)
+    ->ReportAggregatesOnly(false)
+    ->DisplayAggregatesOnly(false);
+
+// Scaling curve of one client shared by all the benchmark threads, spreading its RPCs across state.range(0) channels
+static void benchmark_teiacare_client_channel_pool(benchmark::State& state)
+{
+    static std::mutex clients_mutex;
+    static std::map<int64_t, std::unique_ptr<tc::infer::client_interface>> clients;
+
+    tc::infer::client_interface* client = nullptr;
+    {
+        std::lock_guard lock(clients_mutex);
+        auto& pool_client = clients[state.range(0)];
+        if (!pool_client)
+            pool_client = benchmarks::create_client(tc::infer::client_options{ .channel_pool_size = static_cast<unsigned>(state.range(0)) });
+
+        client = pool_client.get();
+    }
+
+    std::vector<int32_t> data_0 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::vector<int32_t> data_1 { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    std::vector<int64_t> shape { 1, 16 };
+
+    for (auto _ : state)
+    {
+        tc::infer::infer_request request;
+        request.model_name = "simple_int32";
+        request.model_version = "1";
+        request.add_input_tensor(data_0.data(), data_0.size(), shape, "INPUT0");
+        request.add_input_tensor(data_1.data(), data_1.size(), shape, "INPUT1");
+
+        check_response(client->infer(request), data_0, data_1);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(benchmark_teiacare_client_channel_pool)
+    ->ArgName("channels")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->ThreadRange(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(benchmark_teiacare_client_stream)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->Threads(1)
+    ->Iterations(10'000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond)
+    ->ReportAggregatesOnly(false)
+    ->DisplayAggregatesOnly(false);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,241 @@
+#include <benchmark/benchmark.h>
+#include "tensor_converter.hpp"
+#include "simd_convert.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// A/B comparisons of the tensor_converter implementation choices (response parsers, SIMD kernels, prepared requests):
+// the per data type request and response costs are measured by the benchmark_tensor_converter_suite matrix
+
+// Per call encoding of a 4 inputs request: infer_request builds and serializes the whole message header at each call,
+// a prepared_request appends the bound inputs to the header serialized once
+template<bool prepared>
+static void benchmark_get_infer_request_buffer_inputs(benchmark::State& state)
+{
+    constexpr size_t num_inputs = 4;
+    const auto elements = state.range(0);
+    const std::vector<float> data(static_cast<size_t>(elements), 1.0f);
+    const tc::infer::tensor_converter converter;
+
+    std::vector<tc::infer::tensor_spec> inputs;
+    for (size_t i = 0; i < num_inputs; ++i)
+    {
+        inputs.push_back({ "INPUT" + std::to_string(i), { 1, elements }, tc::infer::data_type::Fp32 });
+    }
+
+    tc::infer::prepared_request prepared_request("model", "1", inputs);
+    prepared_request.id = "request";
+    for (size_t i = 0; i < num_inputs; ++i)
+    {
+        prepared_request.set_input(i, std::span<const float>(data));
+    }
+
+    size_t wire_bytes = 0;
+    for (auto _ : state)
+    {
+        if constexpr (prepared)
+        {
+            auto buffer = converter.get_infer_request_buffer(prepared_request);
+            wire_bytes = buffer.Length();
+            benchmark::DoNotOptimize(buffer);
+        }
+        else
+        {
+            tc::infer::infer_request infer_request;
+            infer_request.model_name = "model";
+            infer_request.model_version = "1";
+            infer_request.id = "request";
+            for (const tc::infer::tensor_spec& input : inputs)
+            {
+                infer_request.add_input_tensor_view(std::span<const float>(data), input.shape, input.name);
+            }
+
+            auto buffer = converter.get_infer_request_buffer(infer_request);
+            wire_bytes = buffer.Length();
+            benchmark::DoNotOptimize(buffer);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * elements * static_cast<int64_t>(num_inputs * sizeof(float)));
+    state.counters["wire_bytes"] = static_cast<double>(wire_bytes);
+}
+
+// Widening of 8 and 16 bit integers into the 32 bit typed contents field: RepeatedField::Add over the source
+// iterators (the previous tensor_data_writer implementation) against one reservation plus the SIMD kernels
+template<typename T, bool vectorized>
+static void benchmark_widen_to_32(benchmark::State& state)
+{
+    const auto elements = state.range(0);
+    const std::vector<T> data(static_cast<size_t>(elements), T{ 100 });
+    google::protobuf::RepeatedField<std::conditional_t<std::is_signed_v<T>, int32_t, uint32_t>> contents;
+
+    for (auto _ : state)
+    {
+        contents.Clear();
+        if constexpr (vectorized)
+        {
+            contents.Reserve(static_cast<int>(elements));
+            tc::infer::simd::widen_to_32(data.data(), data.size(), contents.AddNAlreadyReserved(static_cast<int>(elements)));
+        }
+        else
+        {
+            contents.Add(data.begin(), data.end());
+        }
+        benchmark::DoNotOptimize(contents.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * elements * static_cast<int64_t>(sizeof(T)));
+}
+
+// Bulk FP32 to FP16 / BF16 conversion (AVX-512, F16C or AVX2) against the scalar round to nearest even conversion
+template<typename T, bool vectorized>
+static void benchmark_float_to_half(benchmark::State& state)
+{
+    const auto elements = state.range(0);
+    std::vector<float> source(static_cast<size_t>(elements));
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<float>(i % 1000) * 0.37f;
+    }
+
+    std::vector<T> destination(source.size());
+    for (auto _ : state)
+    {
+        if constexpr (!vectorized)
+        {
+            for (size_t i = 0; i < source.size(); ++i)
+            {
+                destination[i] = T(source[i]);
+            }
+        }
+        else if constexpr (std::is_same_v<T, tc::infer::fp16>)
+        {
+            tc::infer::float_to_fp16(source.data(), source.size(), destination.data());
+        }
+        else
+        {
+            tc::infer::float_to_bf16(source.data(), source.size(), destination.data());
+        }
+        benchmark::DoNotOptimize(destination.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * elements * static_cast<int64_t>(sizeof(float)));
+}
+
+static std::string make_response_wire(int64_t byte_size)
+{
+    const std::string output(static_cast<size_t>(byte_size), '\x01');
+
+    inference::ModelInferResponse response;
+    response.set_model_name("model");
+    response.set_model_version("1");
+    auto* tensor = response.add_outputs();
+    tensor->set_name("OUTPUT0");
+    tensor->set_datatype("UINT8");
+    tensor->add_shape(1);
+    tensor->add_shape(byte_size);
+    response.add_raw_output_contents(output);
+    return response.SerializeAsString();
+}
+
+// The received message as a single slice or split in the 16 KiB chunks typical of a TCP transport
+static grpc::ByteBuffer make_response_buffer(const std::string& wire, bool chunked)
+{
+    const size_t slice_size = chunked ? 16 * 1024 : wire.size();
+
+    std::vector<grpc::Slice> slices;
+    for (size_t offset = 0; offset < wire.size(); offset += slice_size)
+    {
+        slices.emplace_back(wire.data() + offset, std::min(slice_size, wire.size() - offset), grpc::Slice::STATIC_SLICE);
+    }
+    return grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+template<bool byte_buffer_parser, bool chunked>
+static void benchmark_get_infer_response(benchmark::State& state)
+{
+    const auto byte_size = state.range(0);
+    const std::string wire = make_response_wire(byte_size);
+    const tc::infer::tensor_converter converter;
+
+    for (auto _ : state)
+    {
+        grpc::ByteBuffer buffer = make_response_buffer(wire, chunked);
+        if constexpr (byte_buffer_parser)
+        {
+            benchmark::DoNotOptimize(converter.get_infer_response(buffer));
+        }
+        else
+        {
+            auto response = std::make_shared<inference::ModelInferResponse>();
+            if (!grpc::SerializationTraits<inference::ModelInferResponse>::Deserialize(&buffer, response.get()).ok())
+                state.SkipWithError("Unable to parse the response");
+
+            benchmark::DoNotOptimize(converter.get_infer_response(response));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * byte_size);
+}
+
+// From 1 MB up to 256 MB raw outputs
+#define RESPONSE_PARSER_BENCHMARK(byte_buffer_parser, chunked)                      \
+    BENCHMARK(benchmark_get_infer_response<byte_buffer_parser, chunked>)            \
+        ->Name("get_infer_response/" #byte_buffer_parser "/" #chunked)              \
+        ->ArgName("bytes")                                                          \
+        ->RangeMultiplier(4)                                                        \
+        ->Range(1 << 20, 1 << 28)                                                   \
+        ->Unit(benchmark::kMicrosecond)
+
+RESPONSE_PARSER_BENCHMARK(false, false);
+RESPONSE_PARSER_BENCHMARK(true, false);
+RESPONSE_PARSER_BENCHMARK(false, true);
+RESPONSE_PARSER_BENCHMARK(true, true);
+
+#define WIDEN_BENCHMARK(T, vectorized)                                   \
+    BENCHMARK(benchmark_widen_to_32<T, vectorized>)                      \
+        ->Name("widen_to_32/" #T "/" #vectorized)                        \
+        ->RangeMultiplier(8)                                             \
+        ->Range(1 << 8, 1 << 24)                                         \
+        ->Arg(3 * 640 * 640)                                             \
+        ->Unit(benchmark::kMicrosecond)
+
+WIDEN_BENCHMARK(int8_t, false);
+WIDEN_BENCHMARK(int8_t, true);
+WIDEN_BENCHMARK(uint8_t, false);
+WIDEN_BENCHMARK(uint8_t, true);
+WIDEN_BENCHMARK(int16_t, false);
+WIDEN_BENCHMARK(int16_t, true);
+WIDEN_BENCHMARK(uint16_t, false);
+WIDEN_BENCHMARK(uint16_t, true);
+
+#define FLOAT_TO_HALF_BENCHMARK(T, vectorized)                           \
+    BENCHMARK(benchmark_float_to_half<tc::infer::T, vectorized>)         \
+        ->Name("float_to_" #T "/" #vectorized)                           \
+        ->RangeMultiplier(8)                                             \
+        ->Range(1 << 8, 1 << 24)                                         \
+        ->Arg(3 * 640 * 640)                                             \
+        ->Unit(benchmark::kMicrosecond)
+
+FLOAT_TO_HALF_BENCHMARK(fp16, false);
+FLOAT_TO_HALF_BENCHMARK(fp16, true);
+FLOAT_TO_HALF_BENCHMARK(bf16, false);
+FLOAT_TO_HALF_BENCHMARK(bf16, true);
+
+BENCHMARK(benchmark_get_infer_request_buffer_inputs<false>)
+    ->Name("get_infer_request_buffer/infer_request")
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 16)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(benchmark_get_infer_request_buffer_inputs<true>)
+    ->Name("get_infer_request_buffer/prepared_request")
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 16)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
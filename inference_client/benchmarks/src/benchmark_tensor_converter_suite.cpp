@@ -0,0 +1,201 @@
+#include <benchmark/benchmark.h>
+#include "tensor_converter.hpp"
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+// Network-free matrix of the tensor_converter costs paid by each infer call:
+// - request: infer_request to ModelInferRequest conversion plus its serialization
+// - request_buffer: infer_request to grpc::ByteBuffer encoding, the path taken by the clients built by create_client
+// - response: parsing of the received ModelInferResponse wire encoding into an infer_response
+// for every data type, raw and typed contents, tensors from 64 B to 512 MB plus the 1x3x640x640 FP32 YOLO input size
+// (--benchmark_filter selects a subset, e.g. --benchmark_filter=/FP32/ or --benchmark_filter=/raw/response/).
+// Typed contents stop at 128 MB: 8 and 16 bit elements are widened to 32 bit and the packed fields grow by doubling
+// while parsed, so a 512 MB typed tensor needs several GB of memory.
+namespace
+{
+constexpr int64_t min_byte_size = 64;
+constexpr int64_t max_raw_byte_size = int64_t{512} << 20;
+constexpr int64_t max_typed_byte_size = int64_t{128} << 20;
+constexpr int64_t yolo_byte_size = 3 * 640 * 640 * sizeof(float);
+
+template<typename T>
+T make_value(size_t i)
+{
+    // Small values, as typical tensors (and single byte varints in the typed contents)
+    if constexpr (std::is_same_v<T, bool>)
+        return i % 2 == 0;
+    else if constexpr (std::is_same_v<T, char>)
+        return static_cast<char>('a' + i % 26);
+    else if constexpr (std::is_same_v<T, tc::infer::fp16> || std::is_same_v<T, tc::infer::bf16>)
+        return T(static_cast<float>(i % 100));
+    else
+        return static_cast<T>(i % 100);
+}
+
+template<typename T>
+struct tensor_data
+{
+    explicit tensor_data(int64_t byte_size)
+        : elements{ static_cast<size_t>(byte_size) / sizeof(T) }
+        , data{ new T[elements] }
+    {
+        for (size_t i = 0; i < elements; ++i)
+        {
+            data[i] = make_value<T>(i);
+        }
+
+        // BYTES tensors are sent as a single element, preceded by its little endian 32 bit length
+        if constexpr (std::is_same_v<T, char>)
+        {
+            const auto length = static_cast<uint32_t>(elements - sizeof(uint32_t));
+            std::memcpy(data.get(), &length, sizeof(length));
+        }
+    }
+
+    tc::infer::infer_request request() const
+    {
+        const int64_t shape_elements = std::is_same_v<T, char> ? 1 : static_cast<int64_t>(elements);
+
+        tc::infer::infer_request request;
+        request.model_name = "model";
+        request.model_version = "1";
+        request.add_input_tensor_view(std::span<const T>(data.get(), elements), { 1, shape_elements }, "INPUT0");
+        return request;
+    }
+
+    size_t elements;
+    std::unique_ptr<T[]> data;
+};
+
+template<typename T>
+void benchmark_request(benchmark::State& state, bool raw_input_contents)
+{
+    const tensor_data<T> tensor(state.range(0));
+    const tc::infer::infer_request infer_request = tensor.request();
+    const tc::infer::tensor_converter converter(raw_input_contents);
+
+    std::string wire;
+    for (auto _ : state)
+    {
+        const inference::ModelInferRequest request = converter.get_infer_request(infer_request);
+        request.SerializeToString(&wire);
+        benchmark::DoNotOptimize(wire.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["wire_bytes"] = static_cast<double>(wire.size());
+}
+
+// Inputs larger than a few KiB are referenced by the ByteBuffer slices instead of being copied
+template<typename T>
+void benchmark_request_buffer(benchmark::State& state, bool raw_input_contents)
+{
+    const tensor_data<T> tensor(state.range(0));
+    const tc::infer::infer_request infer_request = tensor.request();
+    const tc::infer::tensor_converter converter(raw_input_contents);
+
+    size_t wire_bytes = 0;
+    for (auto _ : state)
+    {
+        grpc::ByteBuffer buffer = converter.get_infer_request_buffer(infer_request);
+        wire_bytes = buffer.Length();
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["wire_bytes"] = static_cast<double>(wire_bytes);
+}
+
+template<typename T>
+void benchmark_response(benchmark::State& state, bool raw_output_contents)
+{
+    std::string wire;
+    {
+        // The response carries back the request input, as raw_output_contents or as the same typed contents
+        const tensor_data<T> tensor(state.range(0));
+        inference::ModelInferRequest request = tc::infer::tensor_converter(raw_output_contents).get_infer_request(tensor.request());
+
+        inference::ModelInferResponse response;
+        response.set_model_name("model");
+        response.set_model_version("1");
+        auto* output = response.add_outputs();
+        output->set_name("OUTPUT0");
+        output->set_datatype(request.inputs(0).datatype());
+        *output->mutable_shape() = request.inputs(0).shape();
+        if (request.raw_input_contents_size() > 0)
+            response.add_raw_output_contents(std::move(*request.mutable_raw_input_contents(0)));
+        else
+            output->mutable_contents()->Swap(request.mutable_inputs(0)->mutable_contents());
+
+        response.SerializeToString(&wire);
+    }
+
+    const tc::infer::tensor_converter converter;
+    for (auto _ : state)
+    {
+        grpc::Slice slice(wire.data(), wire.size(), grpc::Slice::STATIC_SLICE);
+        grpc::ByteBuffer buffer(&slice, 1);
+        benchmark::DoNotOptimize(converter.get_infer_response(buffer));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["wire_bytes"] = static_cast<double>(wire.size());
+}
+
+template<typename T>
+void register_benchmarks()
+{
+    const std::string datatype(tc::infer::data_type(tc::infer::cast_to_data_type<T>::type).name());
+
+    // BYTES tensors only have typed contents and FP16/BF16 tensors only raw contents
+    std::vector<bool> raw_contents;
+    if constexpr (!std::is_same_v<T, tc::infer::fp16> && !std::is_same_v<T, tc::infer::bf16>)
+        raw_contents.push_back(false);
+    if constexpr (!std::is_same_v<T, char>)
+        raw_contents.push_back(true);
+
+    for (bool raw : raw_contents)
+    {
+        const std::string prefix = "tensor_converter/" + datatype + "/" + (raw ? "raw" : "typed");
+        const int64_t max_byte_size = raw ? max_raw_byte_size : max_typed_byte_size;
+        const auto register_benchmark = [&](const std::string& name, void (*function)(benchmark::State&, bool))
+        {
+            benchmark::RegisterBenchmark((prefix + "/" + name).c_str(), function, raw)
+                ->RangeMultiplier(8)
+                ->Range(min_byte_size, max_byte_size)
+                ->Arg(yolo_byte_size)
+                ->Unit(benchmark::kMicrosecond);
+        };
+
+        register_benchmark("request", benchmark_request<T>);
+        register_benchmark("request_buffer", benchmark_request_buffer<T>);
+        register_benchmark("response", benchmark_response<T>);
+    }
+}
+
+template<typename... T>
+void register_all_benchmarks()
+{
+    (register_benchmarks<T>(), ...);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    register_all_benchmarks<bool, uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, tc::infer::fp16, tc::infer::bf16, float, double, char>();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,506 @@
+#include "benchmark_server.hpp"
+#include "timings_reports.hpp"
+
+#include <teiacare/inference_client/client_factory.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <semaphore>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Load generator measuring the latencies seen by the client library (conversions and gRPC included) at a given load:
+// - open loop (--mode=open): requests are sent at --rate requests per second (constant or poisson arrivals) whatever the
+//   server throughput. Latencies are measured from the intended send time, so a stalled client or server is charged
+//   for every request it delayed (no coordinated omission)
+// - closed loop (--mode=closed): --concurrency requests are kept in flight, each completion sends the next request
+// The inputs are read from the model metadata (dynamic dimensions set by --shape, or 1) or declared with --input,
+// and are zero filled (empty elements for BYTES inputs) unless --data provides their contents. Any option can also be written, without the leading
+// dashes, as a line of a --config file.
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::string_view usage = R"(usage: teiacare_inference_loadgen [options]
+  --uri=<host:port>              server (default: TC_INFER_SERVER_URI, or an in-process mock server)
+  --model=<name>                 model name (default: simple_int32)
+  --version=<version>            model version (default: 1)
+  --mode=<open|closed>           open loop constant rate or closed loop fixed concurrency (default: closed)
+  --rate=<requests/s>            open loop request rate (default: 1000)
+  --arrival=<constant|poisson>   open loop inter-arrival times (default: constant)
+  --concurrency=<n>              closed loop requests in flight (default: 1)
+  --max_in_flight=<n>            open loop cap of the requests in flight (default: 1024)
+  --duration=<s>                 measured duration in seconds (default: 10)
+  --warmup=<s>                   warm up duration in seconds, not measured (default: 1)
+  --timeout=<ms>                 infer timeout in milliseconds (default: 10000)
+  --channels=<n>                 client_options::channel_pool_size (default: 1)
+  --cq_threads=<n>               client_options::completion_queue_threads (default: 1)
+  --input=<name>:<DTYPE>:<dims>  input declared explicitly (e.g. INPUT0:FP32:1,3,224,224), repeatable
+  --shape=<name>:<dims>          shape of a model metadata input with dynamic dimensions, repeatable
+  --data=<name>:<path>           raw contents of an input read from a file, repeatable
+                                 (BYTES: each element preceded by its little endian 32 bit length)
+  --config=<path>                file of options, one <option>=<value> per line (# comments)
+  --json=<path>, --csv=<path>    machine readable reports ("-" for stdout)
+)";
+
+enum class load_mode
+{
+    open,
+    closed
+};
+
+enum class arrival_process
+{
+    constant,
+    poisson
+};
+
+struct input_config
+{
+    std::string name;
+    tc::infer::data_type datatype;
+    std::vector<int64_t> shape;
+};
+
+struct loadgen_options
+{
+    std::string uri = {};
+    std::string model_name = "simple_int32";
+    std::string model_version = "1";
+    load_mode mode = load_mode::closed;
+    arrival_process arrival = arrival_process::constant;
+    double rate = 1000.0;
+    unsigned concurrency = 1;
+    unsigned max_in_flight = 1024;
+    std::chrono::duration<double> duration = std::chrono::seconds(10);
+    std::chrono::duration<double> warmup = std::chrono::seconds(1);
+    std::chrono::milliseconds timeout = std::chrono::seconds(10);
+    unsigned channels = 1;
+    unsigned completion_queue_threads = 1;
+    std::vector<input_config> inputs = {};
+    std::map<std::string, std::vector<int64_t>> shapes = {};
+    std::map<std::string, std::string> data_paths = {};
+    timings::report_options report = {};
+};
+
+struct loadgen_results
+{
+    timings::latency_histogram histogram;
+    uint64_t completed = 0;
+    uint64_t errors = 0;
+    uint64_t delayed_sends = 0;
+    std::string first_error = {};
+
+    // From the start of the measured window to the last measured completion, longer than --duration when the server falls behind
+    std::chrono::duration<double> elapsed = std::chrono::seconds(0);
+};
+
+std::vector<std::string> split(std::string_view value, char separator)
+{
+    std::vector<std::string> tokens;
+    size_t begin = 0;
+    while (true)
+    {
+        const size_t end = value.find(separator, begin);
+        tokens.emplace_back(value.substr(begin, end - begin));
+        if (end == std::string_view::npos)
+            return tokens;
+
+        begin = end + 1;
+    }
+}
+
+std::vector<int64_t> parse_shape(std::string_view value)
+{
+    std::vector<int64_t> shape;
+    for (const std::string& dim : split(value, ','))
+    {
+        shape.push_back(std::stoll(dim));
+    }
+    return shape;
+}
+
+// Splits "<name>:<value>" at the first separator, as tensor names can not contain ':' but file paths can
+std::pair<std::string, std::string> split_name(std::string_view option, std::string_view value)
+{
+    const size_t separator = value.find(':');
+    if (separator == std::string_view::npos || separator == 0)
+        throw std::invalid_argument("invalid --" + std::string(option) + "=" + std::string(value));
+
+    return { std::string(value.substr(0, separator)), std::string(value.substr(separator + 1)) };
+}
+
+void parse_config_file(loadgen_options& options, const std::string& path);
+
+void set_option(loadgen_options& options, std::string_view key, const std::string& value)
+{
+    if (key == "uri")
+        options.uri = value;
+    else if (key == "model")
+        options.model_name = value;
+    else if (key == "version")
+        options.model_version = value;
+    else if (key == "mode" && (value == "open" || value == "closed"))
+        options.mode = value == "open" ? load_mode::open : load_mode::closed;
+    else if (key == "arrival" && (value == "constant" || value == "poisson"))
+        options.arrival = value == "constant" ? arrival_process::constant : arrival_process::poisson;
+    else if (key == "rate")
+        options.rate = std::stod(value);
+    else if (key == "concurrency")
+        options.concurrency = static_cast<unsigned>(std::stoul(value));
+    else if (key == "max_in_flight")
+        options.max_in_flight = static_cast<unsigned>(std::stoul(value));
+    else if (key == "duration")
+        options.duration = std::chrono::duration<double>(std::stod(value));
+    else if (key == "warmup")
+        options.warmup = std::chrono::duration<double>(std::stod(value));
+    else if (key == "timeout")
+        options.timeout = std::chrono::milliseconds(std::stoll(value));
+    else if (key == "channels")
+        options.channels = static_cast<unsigned>(std::stoul(value));
+    else if (key == "cq_threads")
+        options.completion_queue_threads = static_cast<unsigned>(std::stoul(value));
+    else if (key == "input")
+    {
+        const std::vector<std::string> tokens = split(value, ':');
+        if (tokens.size() != 3 || tc::infer::data_type(tokens[1]) == tc::infer::data_type::Unknown)
+            throw std::invalid_argument("invalid --input=" + value + " (expected <name>:<DTYPE>:<dims>)");
+
+        options.inputs.push_back({ tokens[0], tc::infer::data_type(tokens[1]), parse_shape(tokens[2]) });
+    }
+    else if (key == "shape")
+    {
+        auto [name, shape] = split_name(key, value);
+        options.shapes[name] = parse_shape(shape);
+    }
+    else if (key == "data")
+    {
+        auto [name, path] = split_name(key, value);
+        options.data_paths[name] = path;
+    }
+    else if (key == "config")
+        parse_config_file(options, value);
+    else if (key == "json")
+        options.report.json_path = value;
+    else if (key == "csv")
+        options.report.csv_path = value;
+    else
+        throw std::invalid_argument("invalid option " + std::string(key) + "=" + value);
+}
+
+void set_option(loadgen_options& options, std::string_view option)
+{
+    const size_t separator = option.find('=');
+    if (separator == std::string_view::npos)
+        throw std::invalid_argument("invalid option " + std::string(option) + " (expected <option>=<value>)");
+
+    set_option(options, option.substr(0, separator), std::string(option.substr(separator + 1)));
+}
+
+void parse_config_file(loadgen_options& options, const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("unable to open " + path);
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#')
+            continue;
+
+        set_option(options, std::string_view(line).substr(begin, line.find_last_not_of(" \t\r") + 1 - begin));
+    }
+}
+
+loadgen_options parse_options(int argc, char** argv)
+{
+    loadgen_options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg(argv[i]);
+        if (arg == "--help")
+        {
+            std::cout << usage;
+            std::exit(EXIT_SUCCESS);
+        }
+
+        if (!arg.starts_with("--"))
+            throw std::invalid_argument("invalid argument " + std::string(arg));
+
+        set_option(options, arg.substr(2));
+    }
+
+    options.report.validate();
+    if (options.rate <= 0.0 || options.concurrency == 0 || options.max_in_flight == 0)
+        throw std::invalid_argument("rate, concurrency and max_in_flight must be positive");
+
+    return options;
+}
+
+std::unique_ptr<tc::infer::async_client_interface> create_client(const loadgen_options& options)
+{
+    tc::infer::client_options client_options;
+    client_options.channel_pool_size = options.channels;
+    client_options.completion_queue_threads = options.completion_queue_threads;
+
+    if (!options.uri.empty())
+        return tc::infer::create_async_client(options.uri, client_options);
+
+    return benchmarks::create_async_client(client_options);
+}
+
+std::vector<input_config> resolve_inputs(tc::infer::client_interface& client, const loadgen_options& options)
+{
+    std::vector<input_config> inputs = options.inputs;
+    if (inputs.empty())
+    {
+        const tc::infer::model_metadata metadata = client.model_metadata(options.model_name, options.model_version);
+        for (const auto& input : metadata.inputs)
+        {
+            inputs.push_back({ input.name, tc::infer::data_type(input.datatype), input.shape });
+        }
+    }
+
+    for (input_config& input : inputs)
+    {
+        if (input.datatype == tc::infer::data_type::Unknown)
+            throw std::runtime_error("input " + input.name + " has an unsupported data type");
+
+        if (auto shape = options.shapes.find(input.name); shape != options.shapes.end())
+            input.shape = shape->second;
+
+        for (int64_t& dim : input.shape)
+        {
+            if (dim < 0)
+                dim = 1;
+        }
+    }
+
+    return inputs;
+}
+
+// Number of elements of BYTES contents, each one preceded by its little endian 32 bit length
+size_t bytes_element_count(std::span<const char> contents, const std::string& path)
+{
+    size_t elements = 0;
+    for (size_t offset = 0; offset < contents.size(); ++elements)
+    {
+        if (contents.size() - offset < sizeof(uint32_t))
+            throw std::runtime_error(path + " is truncated in the length of BYTES element " + std::to_string(elements));
+
+        const auto* length_bytes = reinterpret_cast<const unsigned char*>(contents.data() + offset);
+        const size_t length = length_bytes[0] | (length_bytes[1] << 8) | (length_bytes[2] << 16) | (size_t{ length_bytes[3] } << 24);
+        offset += sizeof(uint32_t);
+        if (contents.size() - offset < length)
+            throw std::runtime_error(path + " is truncated in BYTES element " + std::to_string(elements));
+
+        offset += length;
+    }
+    return elements;
+}
+
+std::vector<std::byte> load_input_data(const input_config& input, const loadgen_options& options)
+{
+    size_t elements = 1;
+    for (int64_t dim : input.shape)
+    {
+        elements *= static_cast<size_t>(dim);
+    }
+
+    const auto data_path = options.data_paths.find(input.name);
+    if (data_path == options.data_paths.end())
+    {
+        if (input.datatype == tc::infer::data_type::String)
+            return std::vector<std::byte>(elements * sizeof(uint32_t));
+
+        return std::vector<std::byte>(elements * input.datatype.element_size());
+    }
+
+    std::ifstream file(data_path->second, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("unable to open " + data_path->second);
+
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (input.datatype == tc::infer::data_type::String)
+    {
+        if (const size_t file_elements = bytes_element_count(contents, data_path->second); file_elements != elements)
+            throw std::runtime_error(data_path->second + " has " + std::to_string(file_elements) + " BYTES elements, input " + input.name + " needs " + std::to_string(elements));
+    }
+    else if (contents.size() != elements * input.datatype.element_size())
+        throw std::runtime_error(data_path->second + " has " + std::to_string(contents.size()) + " bytes, input " + input.name + " needs " + std::to_string(elements * input.datatype.element_size()));
+
+    const auto bytes = std::as_bytes(std::span<const char>(contents));
+    return std::vector<std::byte>(bytes.begin(), bytes.end());
+}
+
+loadgen_results run(tc::infer::async_client_interface& client, const tc::infer::infer_request& request, const loadgen_options& options)
+{
+    loadgen_results results;
+    std::mutex results_mutex;
+
+    const unsigned in_flight = options.mode == load_mode::open ? options.max_in_flight : options.concurrency;
+    std::counting_semaphore<> slots(in_flight);
+
+    const auto start = clock_type::now();
+    const auto measure_start = start + std::chrono::duration_cast<clock_type::duration>(options.warmup);
+    const auto end = measure_start + std::chrono::duration_cast<clock_type::duration>(options.duration);
+
+    std::mt19937_64 random_engine(std::random_device{}());
+    std::exponential_distribution<double> inter_arrival(options.rate);
+    std::chrono::duration<double> arrival_offset(0.0);
+    clock_type::time_point last_completion = end;
+
+    for (uint64_t i = 0;; ++i)
+    {
+        clock_type::time_point intended_start;
+        if (options.mode == load_mode::open)
+        {
+            // The schedule does not depend on the completions: a late sender catches up with a burst of requests,
+            // each one measured from its own intended start
+            arrival_offset = options.arrival == arrival_process::constant ? std::chrono::duration<double>(static_cast<double>(i) / options.rate) : arrival_offset + std::chrono::duration<double>(inter_arrival(random_engine));
+            intended_start = start + std::chrono::duration_cast<clock_type::duration>(arrival_offset);
+            if (intended_start >= end)
+                break;
+
+            std::this_thread::sleep_until(intended_start);
+            if (!slots.try_acquire())
+            {
+                ++results.delayed_sends;
+                slots.acquire();
+            }
+        }
+        else
+        {
+            slots.acquire();
+            intended_start = clock_type::now();
+            if (intended_start >= end)
+            {
+                slots.release();
+                break;
+            }
+        }
+
+        const bool measured = intended_start >= measure_start;
+        client.infer_async(
+            request,
+            [&, intended_start, measured](tc::infer::infer_response, std::exception_ptr error)
+            {
+                // The warm up requests, failed or not, are not reported
+                const auto completion = clock_type::now();
+                const auto latency = completion - intended_start;
+                if (measured)
+                {
+                    std::lock_guard lock(results_mutex);
+                    if (error)
+                    {
+                        ++results.errors;
+                        if (results.first_error.empty())
+                        {
+                            try
+                            {
+                                std::rethrow_exception(error);
+                            }
+                            catch (const std::exception& exception)
+                            {
+                                results.first_error = exception.what();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        results.histogram.record(latency);
+                        ++results.completed;
+                        last_completion = std::max(last_completion, completion);
+                    }
+                }
+
+                slots.release();
+            },
+            options.timeout);
+    }
+
+    // Wait for the requests still in flight
+    for (unsigned i = 0; i < in_flight; ++i)
+    {
+        slots.acquire();
+    }
+
+    results.elapsed = last_completion - measure_start;
+    return results;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const loadgen_options options = parse_options(argc, argv);
+        auto client = create_client(options);
+
+        const std::vector<input_config> inputs = resolve_inputs(*client, options);
+        std::vector<std::vector<std::byte>> input_data;
+        tc::infer::infer_request request;
+        request.model_name = options.model_name;
+        request.model_version = options.model_version;
+        for (const input_config& input : inputs)
+        {
+            input_data.push_back(load_input_data(input, options));
+            request.add_input_tensor_view(std::span<const std::byte>(input_data.back()), input.shape, input.datatype, input.name);
+        }
+
+        const bool open_loop = options.mode == load_mode::open;
+        std::ostream& console = options.report.console();
+        console << "=== " << options.model_name << " ";
+        if (open_loop)
+            console << "open loop, " << options.rate << " requests/s ===" << std::endl;
+        else
+            console << "closed loop, " << options.concurrency << " requests in flight ===" << std::endl;
+
+        for (const input_config& input : inputs)
+        {
+            console << input.name << " " << input.datatype.name() << " [";
+            for (size_t i = 0; i < input.shape.size(); ++i)
+            {
+                console << (i > 0 ? "," : "") << input.shape[i];
+            }
+            console << "]" << std::endl;
+        }
+
+        const loadgen_results results = run(*client, request, options);
+
+        timings::report_fields fields;
+        if (open_loop)
+            fields.emplace_back("offered_qps", options.rate);
+        else
+            fields.emplace_back("concurrency", options.concurrency);
+        fields.emplace_back("achieved_qps", static_cast<double>(results.completed) / results.elapsed.count());
+        fields.emplace_back("errors", static_cast<double>(results.errors));
+        if (open_loop)
+            fields.emplace_back("delayed_sends", static_cast<double>(results.delayed_sends));
+
+        timings::report("teiacare_inference_loadgen/" + options.model_name + (open_loop ? "/open" : "/closed"), results.histogram, options.report, fields);
+        if (results.errors > 0)
+            std::cerr << "error: " << results.errors << " failed requests, first error: " << results.first_error << std::endl;
+
+        return results.errors > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << "error: " << exception.what() << "\n\n" << usage;
+        return EXIT_FAILURE;
+    }
+}
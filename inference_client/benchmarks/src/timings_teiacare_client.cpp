@@ -0,0 +1,56 @@
+#include "benchmark_server.hpp"
+#include "timings_reports.hpp"
+
+// Per-request latencies of 10,000 blocking infer calls (after 100 warm up calls), see timings::report_options for the JSON/CSV reports
+int main(int argc, char** argv)
+{
+    const auto report_options = timings::report_options::parse(argc, argv);
+    auto client = benchmarks::create_client();
+
+    std::vector<int32_t> data_0 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::vector<int32_t> data_1 { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    std::vector<int64_t> shape { 1, 16 };
+
+    timings::latency_histogram histogram;
+    for(int n=0; n<100 + 10'000; ++n)
+    {
+        tc::infer::infer_request request;
+        request.model_name = "simple_int32";
+        request.model_version = "1";
+        request.add_input_tensor(data_0.data(), data_0.size(), shape, "INPUT0");
+        request.add_input_tensor(data_1.data(), data_1.size(), shape, "INPUT1");
+
+        // Only the blocking infer call is timed, not the request construction nor the checks of the outputs
+        tc::infer::infer_response response;
+        try
+        {
+            auto start = std::chrono::steady_clock::now();
+            response = client->infer(request);
+            if (n >= 100)
+                histogram.record(std::chrono::steady_clock::now() - start);
+        }
+        catch(...)
+        {
+            return EXIT_FAILURE;
+        }
+
+        auto output0_data = response.output_tensors[0].as<int32_t>();
+        auto output1_data = response.output_tensors[1].as<int32_t>();
+        for (size_t i = 0; i < 16; ++i)
+        {
+            if ((data_0[i] + data_1[i]) != *(output0_data + i))
+            {
+                std::cerr << "error: incorrect sum" << std::endl;
+                exit(1);
+            }
+            if ((data_0[i] - data_1[i]) != *(output1_data + i))
+            {
+                std::cerr << "error: incorrect difference" << std::endl;
+                exit(1);
+            }
+        }
+    }
+
+    timings::report("timings_teiacare_client", histogram, report_options);
+    return EXIT_SUCCESS;
+}
@@ -82,11 +82,10 @@ int main(int argc, char** argv)
     std::vector<int32_t> input1_data { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
     std::vector<int64_t> shape { 1, 16 };
 
-    std::vector<int64_t> times;
-    for(int n=0; n<100; ++n)
+    const auto report_options = timings::report_options::parse(argc, argv);
+    timings::latency_histogram histogram;
+    for(int n=0; n<100 + 10'000; ++n)
     {
-        auto start = std::chrono::steady_clock::now();
-        for (int i = 0; i < 100; ++i)
         {
             // Initialize the inputs with the data.
             tc::InferInput* input0;
@@ -123,8 +122,12 @@ int main(int argc, char** argv)
             std::vector<tc::InferInput*> inputs = { input0_ptr.get(), input1_ptr.get() };
             std::vector<const tc::InferRequestedOutput*> outputs = { output0_ptr.get(), output1_ptr.get() };
 
+            // Only the blocking Infer call is timed, as for timings_teiacare_client
             tc::InferResult* results;
+            auto start = std::chrono::steady_clock::now();
             FAIL_IF_ERR(client->Infer(&results, options, inputs, outputs, http_headers, compression_algorithm), "unable to run model");
+            if (n >= 100)
+                histogram.record(std::chrono::steady_clock::now() - start);
             std::shared_ptr<tc::InferResult> results_ptr;
             results_ptr.reset(results);
 
@@ -161,11 +164,8 @@ int main(int argc, char** argv)
                 }
             }
         }
-
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
-        times.push_back(elapsed.count());
     }
 
-    timings::print_stats(times);
+    timings::report("timings_triton_client", histogram, report_options);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <teiacare/inference_client/awaitable.hpp>
+#include <teiacare/inference_client/client_interface.hpp>
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+
+namespace tc::infer
+{
+class async_client_interface : public virtual client_interface
+{
+public:
+    // Invoked on a completion queue thread: error is set (and response empty) when the call failed. Requests failing
+    // before being sent (e.g. invalid_request_error) are reported in the same way, on the calling thread
+    using infer_callback = std::function<void(tc::infer::infer_response response, std::exception_ptr error)>;
+
+    virtual ~async_client_interface() = default;
+
+    virtual std::future<tc::infer::infer_response> infer_async(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout = std::chrono::seconds(1)) = 0;
+    virtual void infer_async(const tc::infer::infer_request& infer_request, infer_callback callback, std::chrono::milliseconds infer_timeout = std::chrono::seconds(1)) = 0;
+
+    // Coroutine API: co_await resumes the caller on a completion queue thread, without blocking any thread while the call is in flight
+    virtual tc::infer::awaitable<tc::infer::infer_response> infer_co(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout = std::chrono::seconds(1)) = 0;
+    virtual tc::infer::awaitable<bool> is_model_ready_co(const std::string& model_name, const std::string& model_version) = 0;
+    virtual tc::infer::awaitable<tc::infer::model_metadata> model_metadata_co(const std::string& model_name, const std::string& model_version) = 0;
+};
+
+}
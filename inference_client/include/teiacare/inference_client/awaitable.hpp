@@ -0,0 +1,57 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace tc::infer
+{
+// Awaitable result of an asynchronous client call. The RPC is started when the awaitable is
+// co_awaited, and the awaiting coroutine is resumed on the completion queue thread that received the result.
+template<typename T>
+class awaitable
+{
+public:
+    using result_callback = std::function<void(T result, std::exception_ptr error)>;
+    using start_function = std::function<void(result_callback)>;
+
+    explicit awaitable(start_function start)
+        : _start{ std::move(start) }
+    {
+    }
+
+    [[nodiscard]]
+    inline bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    inline void await_suspend(std::coroutine_handle<> handle)
+    {
+        // The coroutine (and this awaitable with it) may be resumed and destroyed before start returns
+        auto start = std::move(_start);
+        start([this, handle](T result, std::exception_ptr error)
+        {
+            _result.emplace(std::move(result));
+            _error = error;
+            handle.resume();
+        });
+    }
+
+    inline T await_resume()
+    {
+        if (_error)
+            std::rethrow_exception(_error);
+
+        return std::move(*_result);
+    }
+
+private:
+    start_function _start;
+    std::optional<T> _result;
+    std::exception_ptr _error;
+};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace tc::infer
+{
+// bfloat16 value: the high half of an IEEE 754 binary32, stored with the same layout of the BF16 tensor elements on the wire.
+// Conversions from float round to nearest even.
+class bf16
+{
+public:
+    bf16() = default;
+
+    explicit constexpr bf16(float value) noexcept
+        : _bits{ from_float(value) }
+    {
+    }
+
+    [[nodiscard]]
+    static constexpr bf16 from_bits(uint16_t bits) noexcept
+    {
+        bf16 value;
+        value._bits = bits;
+        return value;
+    }
+
+    [[nodiscard]]
+    inline constexpr uint16_t bits() const noexcept
+    {
+        return _bits;
+    }
+
+    [[nodiscard]]
+    explicit constexpr operator float() const noexcept
+    {
+        return std::bit_cast<float>(static_cast<uint32_t>(_bits) << 16);
+    }
+
+    // Bitwise comparison, so that NaN values compare equal to themselves
+    friend constexpr bool operator==(bf16 lhs, bf16 rhs) noexcept = default;
+
+private:
+    static constexpr uint16_t from_float(float value) noexcept
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+
+        // NaN is truncated and made quiet, so that dropping its low payload bits cannot turn it into Inf
+        if ((bits & 0x7FFFFFFF) > 0x7F800000)
+            return static_cast<uint16_t>((bits >> 16) | 0x40);
+
+        // Adding 0x7FFF plus the lowest kept bit rounds to nearest even, carrying into the exponent (or Inf) when needed
+        return static_cast<uint16_t>((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+    }
+
+    uint16_t _bits = 0;
+};
+
+static_assert(sizeof(bf16) == 2);
+
+// Bulk conversions, vectorized with AVX-512 or AVX2 when the CPU supports them
+void float_to_bf16(const float* source, size_t size, bf16* destination) noexcept;
+void bf16_to_float(const bf16* source, size_t size, float* destination) noexcept;
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <teiacare/inference_client/async_client_interface.hpp>
 #include <teiacare/inference_client/client_interface.hpp>
+#include <teiacare/inference_client/client_options.hpp>
 #include <memory>
 #include <string>
 #include <chrono>
@@ -8,6 +10,8 @@
 namespace tc::infer
 {
 std::unique_ptr<client_interface> create_client(const std::string& uri, std::chrono::milliseconds rpc_timeout = std::chrono::seconds(5));
+std::unique_ptr<client_interface> create_client(const std::string& uri, const client_options& options);
+std::unique_ptr<async_client_interface> create_async_client(const std::string& uri, const client_options& options = client_options{});
 
 // #if defined(UNIT_TESTS)
 // #include <services.grpc.pb.h>
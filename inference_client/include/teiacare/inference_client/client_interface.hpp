@@ -1,12 +1,18 @@
 #pragma once
 
+#include <teiacare/inference_client/client_statistics.hpp>
 #include <teiacare/inference_client/infer_request.hpp>
 #include <teiacare/inference_client/infer_response.hpp>
+#include <teiacare/inference_client/infer_stream_interface.hpp>
+#include <teiacare/inference_client/invalid_request_error.hpp>
+#include <teiacare/inference_client/prepared_request.hpp>
 #include <teiacare/inference_client/server_metadata.hpp>
+#include <teiacare/inference_client/shared_memory.hpp>
 #include <teiacare/inference_client/model_metadata.hpp>
 #include <teiacare/inference_client/timeout_error.hpp>
 
 #include <vector>
+#include <memory>
 #include <string>
 #include <chrono>
 
@@ -26,6 +32,14 @@ public:
     virtual bool model_unload(const std::string& model_name, const std::string& model_version) = 0;
     virtual tc::infer::model_metadata model_metadata(const std::string& model_name, const std::string& model_version) = 0;
     virtual tc::infer::infer_response infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout = std::chrono::seconds(1)) = 0;
+    virtual tc::infer::infer_response infer(const tc::infer::prepared_request& prepared_request, std::chrono::milliseconds infer_timeout = std::chrono::seconds(1)) = 0;
+    virtual std::unique_ptr<tc::infer::infer_stream_interface> create_infer_stream() = 0;
+    virtual bool system_shared_memory_register(const std::string& region_name, const std::string& key, size_t byte_size, size_t offset = 0) = 0;
+    virtual bool system_shared_memory_unregister(const std::string& region_name = "") = 0;
+    virtual std::vector<tc::infer::shared_memory_status> system_shared_memory_status(const std::string& region_name = "") = 0;
+
+    // Per model version counters and latency histograms of the infer calls made by this client since its creation
+    virtual tc::infer::client_statistics statistics() const = 0;
 };
 
 }
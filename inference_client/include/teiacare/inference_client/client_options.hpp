@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace tc::infer
+{
+enum class channel_selection
+{
+    round_robin,
+    least_loaded
+};
+
+struct client_options
+{
+    std::chrono::milliseconds rpc_timeout = std::chrono::seconds(5);
+
+    // Number of independent channels (each one with its own HTTP/2 connection) the RPCs are spread across
+    unsigned channel_pool_size = 1;
+    tc::infer::channel_selection channel_selection = tc::infer::channel_selection::round_robin;
+
+    // Send input tensors as raw_input_contents (one bytes blob per tensor) instead of typed InferTensorContents
+    bool raw_input_contents = true;
+
+    // Number of threads serving the completion queue of clients created with create_async_client
+    unsigned completion_queue_threads = 1;
+
+    // Coalesce concurrent infer calls for the same model into a single request, concatenating the input tensors along
+    // dimension 0 (clients created with create_client only). A batch is sent when it reaches max_batch_size rows
+    // or when batching_window has elapsed since its first request
+    bool dynamic_batching = false;
+    int64_t max_batch_size = 8;
+    std::chrono::microseconds batching_window = std::chrono::microseconds(500);
+
+    // Cache the model metadata for model_metadata_ttl (model_load and model_unload drop the cached versions of the model)
+    // and validate the infer requests against it before sending them: unknown input names, data types, ranks and
+    // non dynamic dimensions mismatches throw invalid_request_error without any round trip to the server.
+    // Asynchronous calls only validate against already cached metadata, so that they never wait for a metadata RPC
+    bool model_metadata_cache = false;
+    std::chrono::milliseconds model_metadata_ttl = std::chrono::seconds(60);
+};
+
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tc::infer
+{
+// Latencies in log-linear buckets: exact below 2^SubBucketBits ns, then 2^SubBucketBits buckets for each power of two
+// (relative error below 2^-SubBucketBits) up to 2^MaxBits ns
+template<int SubBucketBits, int MaxBits>
+struct basic_latency_histogram
+{
+    static constexpr int64_t sub_bucket_count = int64_t{1} << SubBucketBits;
+    static constexpr int64_t max_trackable_value = (int64_t{1} << MaxBits) - 1;
+    static constexpr size_t bucket_count = static_cast<size_t>(sub_bucket_count * (MaxBits - SubBucketBits + 1));
+
+    std::array<uint64_t, bucket_count> counts = {};
+    uint64_t count = 0;
+    std::chrono::nanoseconds sum = std::chrono::nanoseconds(0);
+    std::chrono::nanoseconds max = std::chrono::nanoseconds(0);
+
+    [[nodiscard]]
+    static constexpr size_t bucket_index(int64_t nanoseconds) noexcept
+    {
+        if (nanoseconds < sub_bucket_count)
+            return nanoseconds > 0 ? static_cast<size_t>(nanoseconds) : 0;
+
+        const auto value = static_cast<uint64_t>(nanoseconds < max_trackable_value ? nanoseconds : max_trackable_value);
+        const int shift = std::bit_width(value) - (SubBucketBits + 1);
+        return static_cast<size_t>(sub_bucket_count * shift) + static_cast<size_t>(value >> shift);
+    }
+
+    // Highest latency recorded in the bucket
+    [[nodiscard]]
+    static constexpr std::chrono::nanoseconds bucket_upper_bound(size_t index) noexcept
+    {
+        const auto bucket = static_cast<int64_t>(index);
+        if (bucket < 2 * sub_bucket_count)
+            return std::chrono::nanoseconds(bucket);
+
+        const int64_t shift = bucket / sub_bucket_count - 1;
+        const int64_t sub_bucket = bucket - sub_bucket_count * shift;
+        return std::chrono::nanoseconds(((sub_bucket + 1) << shift) - 1);
+    }
+
+    void record(std::chrono::nanoseconds latency) noexcept
+    {
+        ++counts[bucket_index(latency.count())];
+        ++count;
+        sum += latency;
+        max = std::max(max, latency);
+    }
+
+    [[nodiscard]]
+    std::chrono::nanoseconds mean() const noexcept
+    {
+        return count > 0 ? sum / static_cast<int64_t>(count) : std::chrono::nanoseconds(0);
+    }
+
+    // Upper bound of the bucket holding the percentile (0 to 100), capped to the maximum latency
+    [[nodiscard]]
+    std::chrono::nanoseconds percentile(double percentile) const noexcept
+    {
+        if (count == 0)
+            return std::chrono::nanoseconds(0);
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(count))));
+        uint64_t cumulative_count = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            cumulative_count += counts[i];
+            if (cumulative_count >= rank)
+                return std::min(bucket_upper_bound(i), max);
+        }
+
+        return max;
+    }
+
+    void merge(const basic_latency_histogram& other) noexcept
+    {
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            counts[i] += other.counts[i];
+        }
+
+        count += other.count;
+        sum += other.sum;
+        max = std::max(max, other.max);
+    }
+};
+
+// Latencies of the client statistics: 16 buckets for each power of two (relative error below 6.25%) up to ~18 minutes
+using latency_histogram = basic_latency_histogram<4, 40>;
+
+// Infer calls (infer, infer_async and infer_co) of a model version, completed successfully or not
+struct model_statistics
+{
+    static constexpr size_t status_code_count = 17;
+
+    std::string model_name;
+    std::string model_version;
+
+    uint64_t request_count = 0;
+    uint64_t success_count = 0;
+
+    // RPCs failed with each grpc::StatusCode (DEADLINE_EXCEEDED failures are also the timeout_count)
+    std::array<uint64_t, status_code_count> failures_by_status = {};
+    uint64_t timeout_count = 0;
+
+    // Calls failed in the client, before sending the request (e.g. invalid_request_error) or reading the response
+    uint64_t client_error_count = 0;
+
+    // Wire size of the requests sent and of the responses received
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+
+    // Whole calls (request conversion, RPC and response conversion) and RPCs only (from the start of the call to the
+    // response, server time included): their difference is the time spent in the client
+    tc::infer::latency_histogram latency;
+    tc::infer::latency_histogram rpc_latency;
+};
+
+// Snapshot of the counters maintained by the client since its creation. Counters of calls completing while the snapshot
+// is taken may be partially included
+struct client_statistics
+{
+    // Sorted by model name and version
+    std::vector<model_statistics> models;
+};
+
+}
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <teiacare/inference_client/bf16.hpp>
+#include <teiacare/inference_client/fp16.hpp>
+
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <map>
 #include <string>
+#include <string_view>
 
 namespace tc::infer
 {
+struct data_type_info
+{
+    std::string_view name;
+    size_t element_size;
+};
+
 class data_type
 {
 public:
@@ -24,22 +35,97 @@ public:
         Fp32,
         Fp64,
         String,
+
+        // Added after the original data types to keep their values
+        Bf16,
         Unknown,
     };
 
-    data_type() : _value{value::Unknown} {}
-    data_type(data_type::value value) : _value(value) {}
+    constexpr data_type() : _value{value::Unknown} {}
+    constexpr data_type(data_type::value value) : _value(value) {}
+    constexpr data_type(std::string_view str_value) : _value(from_string(str_value)) {}
+    constexpr data_type(const char* str_value) : _value(from_string(str_value)) {}
     data_type(const std::string& str_value) : _value(from_string(str_value)) {}
 
     constexpr operator value() const { return _value; }
 
-    [[nodiscard]] static data_type::value from_string(const std::string& str_value);
-    [[nodiscard]] std::string str() const;
+    // Parses the KServe wire name of the data type, Unknown if not supported
+    [[nodiscard]] static constexpr data_type::value from_string(std::string_view str_value) noexcept
+    {
+        if (str_value.size() < 4)
+            return data_type::Unknown;
+
+        // The first character and the length narrow the candidates to a single name
+        switch (str_value[0])
+        {
+            case 'B':
+                return str_value[1] == 'O' ? match(str_value, data_type::Bool) : str_value[1] == 'F' ? match(str_value, data_type::Bf16) : match(str_value, data_type::String);
+            case 'F':
+                return str_value[2] == '1' ? match(str_value, data_type::Fp16) : str_value[2] == '3' ? match(str_value, data_type::Fp32) : match(str_value, data_type::Fp64);
+            case 'I':
+                return match(str_value, integer_type(str_value[3], data_type::Int8, data_type::Int16, data_type::Int32, data_type::Int64));
+            case 'U':
+                return str_value.size() < 5 ? data_type::Unknown : match(str_value, integer_type(str_value[4], data_type::Uint8, data_type::Uint16, data_type::Uint32, data_type::Uint64));
+            default:
+                return data_type::Unknown;
+        }
+    }
+
+    // KServe wire name, "Unknown" for the Unknown data type
+    [[nodiscard]] constexpr std::string_view name() const noexcept
+    {
+        return registry[_value].name;
+    }
+
+    // Size in bytes of a tensor element, 0 for BYTES (variable size) and Unknown
+    [[nodiscard]] constexpr size_t element_size() const noexcept
+    {
+        return registry[_value].element_size;
+    }
+
+    [[nodiscard]] std::string str() const
+    {
+        return std::string(name());
+    }
 
 private:
+    static constexpr std::array<data_type_info, value::Unknown + 1> registry
+    {{
+        { "BOOL",    1 },
+        { "UINT8",   1 },
+        { "UINT16",  2 },
+        { "UINT32",  4 },
+        { "UINT64",  8 },
+        { "INT8",    1 },
+        { "INT16",   2 },
+        { "INT32",   4 },
+        { "INT64",   8 },
+        { "FP16",    2 },
+        { "FP32",    4 },
+        { "FP64",    8 },
+        { "BYTES",   0 },
+        { "BF16",    2 },
+        { "Unknown", 0 },
+    }};
+
+    static constexpr data_type::value match(std::string_view str_value, data_type::value candidate) noexcept
+    {
+        return str_value == registry[candidate].name ? candidate : data_type::Unknown;
+    }
+
+    static constexpr data_type::value integer_type(char digit, data_type::value type_8, data_type::value type_16, data_type::value type_32, data_type::value type_64) noexcept
+    {
+        switch (digit)
+        {
+            case '8': return type_8;
+            case '1': return type_16;
+            case '3': return type_32;
+            case '6': return type_64;
+            default: return data_type::Unknown;
+        }
+    }
+
     value _value = value::Unknown;
-    static std::map<data_type::value, std::string> to_string;
-    static std::map<std::string, data_type::value> to_type;
 };
 
 template <typename T>
@@ -50,10 +136,15 @@ struct cast_to_data_type<bool> {
   static constexpr data_type::value type = data_type::value::Bool;
 };
 
-// template <>
-// struct cast_to_data_type<fp16> {
-//   static constexpr data_type::value type = data_type::value::Fp16;
-// };
+template <>
+struct cast_to_data_type<fp16> {
+  static constexpr data_type::value type = data_type::value::Fp16;
+};
+
+template <>
+struct cast_to_data_type<bf16> {
+  static constexpr data_type::value type = data_type::value::Bf16;
+};
 
 template <>
 struct cast_to_data_type<float> {
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace tc::infer
+{
+// IEEE 754 binary16 value, stored with the same layout of the FP16 tensor elements on the wire.
+// Conversions from float round to nearest even, as the F16C and AVX-512 conversions used by the bulk helpers below.
+class fp16
+{
+public:
+    fp16() = default;
+
+    explicit constexpr fp16(float value) noexcept
+        : _bits{ from_float(value) }
+    {
+    }
+
+    [[nodiscard]]
+    static constexpr fp16 from_bits(uint16_t bits) noexcept
+    {
+        fp16 value;
+        value._bits = bits;
+        return value;
+    }
+
+    [[nodiscard]]
+    inline constexpr uint16_t bits() const noexcept
+    {
+        return _bits;
+    }
+
+    [[nodiscard]]
+    explicit constexpr operator float() const noexcept
+    {
+        return to_float(_bits);
+    }
+
+    // Bitwise comparison, so that NaN values compare equal to themselves
+    friend constexpr bool operator==(fp16 lhs, fp16 rhs) noexcept = default;
+
+private:
+    static constexpr uint16_t from_float(float value) noexcept
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const uint32_t abs = bits & 0x7FFFFFFF;
+
+        // NaN keeps the high bits of its payload and becomes quiet, Inf and overflows become Inf
+        if (abs > 0x7F800000)
+            return static_cast<uint16_t>(sign | 0x7E00 | ((abs >> 13) & 0x3FF));
+
+        if (abs >= 0x47800000)
+            return static_cast<uint16_t>(sign | 0x7C00);
+
+        // Below half of the smallest subnormal (2^-25, ties included) the value rounds to zero
+        if (abs <= 0x33000000)
+            return sign;
+
+        uint32_t result = 0;
+        uint32_t remainder = 0;
+        uint32_t halfway = 0;
+        if (abs < 0x38800000)
+        {
+            // Subnormal: the mantissa (with its implicit bit) is expressed in units of 2^-24
+            const uint32_t shift = 126 - (abs >> 23);
+            const uint32_t mantissa = (abs & 0x7FFFFF) | 0x800000;
+            result = mantissa >> shift;
+            remainder = mantissa & ((1u << shift) - 1);
+            halfway = 1u << (shift - 1);
+        }
+        else
+        {
+            // Normal: rebias the exponent (127 - 15) and drop 13 mantissa bits, a carry may round up to the next exponent (or Inf)
+            result = (abs - 0x38000000) >> 13;
+            remainder = abs & 0x1FFF;
+            halfway = 0x1000;
+        }
+
+        if (remainder > halfway || (remainder == halfway && (result & 1)))
+            ++result;
+
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    static constexpr float to_float(uint16_t value) noexcept
+    {
+        const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1F;
+        uint32_t mantissa = value & 0x3FF;
+
+        // Inf, or NaN made quiet as the hardware conversions do
+        if (exponent == 0x1F)
+            return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13) | (mantissa ? 0x400000 : 0));
+
+        if (exponent != 0)
+            return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+
+        if (mantissa == 0)
+            return std::bit_cast<float>(sign);
+
+        // Subnormal: normalize the mantissa into a float exponent
+        uint32_t float_exponent = 113;
+        while (!(mantissa & 0x400))
+        {
+            mantissa <<= 1;
+            --float_exponent;
+        }
+
+        return std::bit_cast<float>(sign | (float_exponent << 23) | ((mantissa & 0x3FF) << 13));
+    }
+
+    uint16_t _bits = 0;
+};
+
+static_assert(sizeof(fp16) == 2);
+
+// Bulk conversions, vectorized with AVX-512 or F16C when the CPU supports them
+void float_to_fp16(const float* source, size_t size, fp16* destination) noexcept;
+void fp16_to_float(const fp16* source, size_t size, float* destination) noexcept;
+
+}
@@ -2,14 +2,24 @@
 
 #include <teiacare/inference_client/infer_tensor.hpp>
 #include <teiacare/inference_client/data_type.hpp>
+#include <teiacare/inference_client/shared_memory.hpp>
 
 #include <cstdint>
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
 
 namespace tc::infer
 {
+struct requested_output
+{
+    std::string name;
+    std::optional<shared_memory_binding> shared_memory;
+};
+
 struct infer_request
 {
     std::string model_name;
@@ -17,6 +27,11 @@ struct infer_request
     std::string id;
     std::vector<infer_tensor> input_tensors;
 
+    // When empty the server returns all the model outputs
+    std::vector<requested_output> requested_outputs;
+
+    // BYTES (char) tensor data holds each element preceded by its little endian 32 bit length, as Triton raw BYTES contents
+
     inline void add_input_tensor(std::byte* data, const size_t size, const std::vector<int64_t>& shape, data_type data_type, const std::string& name) 
     { 
         input_tensors.emplace_back(std::vector<std::byte>(data, data+size), shape, data_type, name);
@@ -27,6 +42,43 @@ struct infer_request
     { 
         add_input_tensor(std::bit_cast<std::byte*>(data), size * sizeof(T), shape, cast_to_data_type<T>::type, name);
     }
+
+    // The tensor borrows the caller memory instead of copying it: data must stay valid and unmodified
+    // until the infer call using this request (or any copy of it) has returned.
+    inline void add_input_tensor_view(std::span<const std::byte> data, const std::vector<int64_t>& shape, data_type data_type, const std::string& name) 
+    { 
+        std::shared_ptr<const std::byte> borrowed_data(std::shared_ptr<const std::byte>{}, data.data());
+        input_tensors.emplace_back(std::move(borrowed_data), data.size(), shape, data_type, name);
+    }
+
+    template<typename T>
+    inline void add_input_tensor_view(std::span<const T> data, const std::vector<int64_t>& shape, const std::string& name) 
+    { 
+        add_input_tensor_view(std::as_bytes(data), shape, cast_to_data_type<T>::type, name);
+    }
+
+    template<typename T>
+    inline void add_input_tensor_view(const T* data, const size_t size, const std::vector<int64_t>& shape, const std::string& name)
+    {
+        add_input_tensor_view(std::span<const T>(data, size), shape, name);
+    }
+
+    // The input contents are read by the server from a registered shared memory region instead of being sent with the request
+    inline void add_input_tensor_shared_memory(const shared_memory_binding& shared_memory, const std::vector<int64_t>& shape, data_type data_type, const std::string& name)
+    {
+        input_tensors.emplace_back(shared_memory, shape, data_type, name);
+    }
+
+    inline void add_requested_output(const std::string& name)
+    {
+        requested_outputs.push_back({ name, std::nullopt });
+    }
+
+    // The server writes the output contents into a registered shared memory region instead of sending them with the response
+    inline void add_requested_output_shared_memory(const std::string& name, const shared_memory_binding& shared_memory)
+    {
+        requested_outputs.push_back({ name, shared_memory });
+    }
 };
 
 }
\ No newline at end of file
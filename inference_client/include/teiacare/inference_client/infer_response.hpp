@@ -18,6 +18,11 @@ struct infer_response
     {
         output_tensors.push_back(output);
     }
+
+    void add_output_tensor(infer_tensor&& output)
+    {
+        output_tensors.push_back(std::move(output));
+    }
 };
 
 }
\ No newline at end of file
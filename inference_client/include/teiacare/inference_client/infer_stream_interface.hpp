@@ -0,0 +1,20 @@
+#pragma once
+
+#include <teiacare/inference_client/infer_request.hpp>
+#include <teiacare/inference_client/infer_response.hpp>
+
+#include <future>
+
+namespace tc::infer
+{
+// Long-lived bidirectional ModelStreamInfer session: many requests can be in flight at the same time,
+// responses are matched to their requests by id (requests without an id get a unique one assigned).
+class infer_stream_interface
+{
+public:
+    virtual ~infer_stream_interface() = default;
+
+    virtual std::future<tc::infer::infer_response> infer(const tc::infer::infer_request& infer_request) = 0;
+};
+
+}
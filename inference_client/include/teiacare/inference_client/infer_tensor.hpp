@@ -1,9 +1,12 @@
 #pragma once
 
 #include <teiacare/inference_client/data_type.hpp>
+#include <teiacare/inference_client/shared_memory.hpp>
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 #include <numeric>
@@ -15,10 +18,32 @@ class infer_tensor
 {
 public:
     explicit infer_tensor(std::vector<std::byte> data, std::vector<int64_t> shape, data_type datatype, const std::string& name)
-        : _data{ data }
+        : _byte_size{ data.size() }
         , _shape { std::move(shape) }
         , _datatype{ std::move(datatype) }
         , _name { std::move(name) }
+    {
+        auto buffer = std::make_shared<const std::vector<std::byte>>(std::move(data));
+        _data = std::shared_ptr<const std::byte>(buffer, buffer->data());
+    }
+
+    // Shares ownership of a buffer owned elsewhere (e.g. the received ModelInferResponse), without copying its bytes
+    explicit infer_tensor(std::shared_ptr<const std::byte> data, size_t byte_size, std::vector<int64_t> shape, data_type datatype, const std::string& name)
+        : _data{ std::move(data) }
+        , _byte_size{ byte_size }
+        , _shape { std::move(shape) }
+        , _datatype{ std::move(datatype) }
+        , _name { std::move(name) }
+    {
+    }
+
+    // The tensor contents are stored in a shared memory region registered on the server and are not part of the message
+    explicit infer_tensor(shared_memory_binding shared_memory, std::vector<int64_t> shape, data_type datatype, const std::string& name)
+        : _byte_size{ shared_memory.byte_size }
+        , _shape { std::move(shape) }
+        , _datatype{ std::move(datatype) }
+        , _name { std::move(name) }
+        , _shared_memory{ std::move(shared_memory) }
     {
     }
 
@@ -46,17 +71,36 @@ public:
         return std::accumulate(_shape.begin(), _shape.end(), size_t{1}, std::multiplies<>());
     }
 
+    [[nodiscard]]
+    inline size_t byte_size() const noexcept
+    {
+        return _byte_size;
+    }
+
     [[nodiscard]]
     inline const std::byte* raw_data() const noexcept
     {
-        return _data.data();
+        return _data.get();
+    }
+
+    // Owning pointer to the tensor bytes, to build tensors aliasing (part of) this tensor buffer
+    [[nodiscard]]
+    inline std::shared_ptr<const std::byte> shared_data() const noexcept
+    {
+        return _data;
+    }
+
+    [[nodiscard]]
+    inline const std::optional<shared_memory_binding>& shared_memory() const noexcept
+    {
+        return _shared_memory;
     }
 
     template<typename T>
     [[nodiscard]]
     inline const T* as() const noexcept
     {
-        return std::bit_cast<const T*>(_data.data());
+        return std::bit_cast<const T*>(_data.get());
     }
 
     template<typename T>
@@ -64,8 +108,8 @@ public:
     inline std::vector<T> data() const noexcept
     {
         return std::vector<T>(
-            std::bit_cast<T*>(_data.data()), 
-            std::bit_cast<T*>(_data.data() + _data.size())
+            std::bit_cast<const T*>(_data.get()), 
+            std::bit_cast<const T*>(_data.get() + _byte_size)
         );
     }
 
@@ -76,7 +120,7 @@ public:
         const auto size = data_size();
         std::vector<T> clone;
         clone.reserve(size);
-        T* data = std::bit_cast<T*>(_data.data());
+        const T* data = std::bit_cast<const T*>(_data.get());
         for (size_t i = 0; i < size; ++i)
         {
             clone.push_back(data[i]);
@@ -85,10 +129,12 @@ public:
     }
 
 private:
-    std::vector<std::byte> _data;
+    std::shared_ptr<const std::byte> _data;
+    size_t _byte_size;
     std::vector<int64_t> _shape;
     data_type _datatype;
     std::string _name;
+    std::optional<shared_memory_binding> _shared_memory;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace tc::infer
+{
+class invalid_request_error : public std::runtime_error
+{
+public:
+    explicit invalid_request_error(const std::string arg) : std::runtime_error(arg) {}
+    virtual ~invalid_request_error() noexcept = default;
+};
+
+}
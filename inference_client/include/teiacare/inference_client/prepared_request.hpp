@@ -0,0 +1,91 @@
+#pragma once
+
+#include <teiacare/inference_client/data_type.hpp>
+#include <teiacare/inference_client/infer_tensor.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tc::infer
+{
+struct tensor_spec
+{
+    std::string name;
+    std::vector<int64_t> shape;
+    data_type datatype;
+};
+
+struct prepared_request_skeleton;
+
+// Request for repeated calls of the same model with fixed input names, shapes and data types.
+// The message skeleton (names, shapes, data types and its wire encoding) is built once and shared by the copies
+// of the prepared request, so each call only binds the input data. Bound data is borrowed: it must stay valid and
+// unmodified until the infer call using it has returned. A prepared request is not meant to be shared between threads,
+// copies are cheap and can be bound independently.
+class prepared_request
+{
+public:
+    explicit prepared_request(const std::string& model_name, const std::string& model_version, std::vector<tensor_spec> inputs, std::vector<std::string> requested_outputs = {});
+
+    // Optional request identifier, sent with the next calls
+    std::string id;
+
+    [[nodiscard]]
+    const std::string& model_name() const noexcept;
+
+    [[nodiscard]]
+    const std::string& model_version() const noexcept;
+
+    [[nodiscard]]
+    const std::vector<tensor_spec>& inputs() const noexcept;
+
+    [[nodiscard]]
+    size_t input_index(const std::string& name) const;
+
+    // The byte size must match the input shape and data type. BYTES inputs are length delimited instead (each element is
+    // preceded by its little endian 32 bit length) and their number of elements must match the input shape
+    void set_input(size_t index, std::span<const std::byte> data);
+
+    // Shares the ownership of the tensor data instead of borrowing it
+    void set_input(size_t index, const tc::infer::infer_tensor& tensor);
+
+    template<typename T>
+    inline void set_input(size_t index, std::span<const T> data)
+    {
+        if (inputs().at(index).datatype != cast_to_data_type<T>::type)
+            throw std::runtime_error("Data type mismatch for input '" + inputs().at(index).name + "' of the prepared request");
+
+        set_input(index, std::as_bytes(data));
+    }
+
+    struct bound_input
+    {
+        std::shared_ptr<const std::byte> data;
+        size_t byte_size = 0;
+    };
+
+    [[nodiscard]]
+    inline const std::vector<bound_input>& bound_inputs() const noexcept
+    {
+        return _bound_inputs;
+    }
+
+    [[nodiscard]]
+    inline const prepared_request_skeleton& skeleton() const noexcept
+    {
+        return *_skeleton;
+    }
+
+private:
+    void bind(size_t index, std::shared_ptr<const std::byte> data, size_t byte_size);
+
+    std::shared_ptr<const prepared_request_skeleton> _skeleton;
+    std::vector<bound_input> _bound_inputs;
+};
+
+}
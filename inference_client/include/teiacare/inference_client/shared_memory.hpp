@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace tc::infer
+{
+// Location of a tensor inside a shared memory region registered on the server
+struct shared_memory_binding
+{
+    std::string region_name;
+    size_t byte_size = 0;
+    size_t offset = 0;
+};
+
+struct shared_memory_status
+{
+    std::string name;
+    std::string key;
+    uint64_t offset = 0;
+    uint64_t byte_size = 0;
+};
+
+// POSIX shared memory object created (shm_open + ftruncate) and mapped by the client.
+// The object is unmapped and unlinked on destruction, so it must outlive its registration on the server.
+class system_shared_memory_region
+{
+public:
+    explicit system_shared_memory_region(const std::string& key, size_t byte_size);
+    ~system_shared_memory_region();
+
+    system_shared_memory_region(system_shared_memory_region&& other) noexcept;
+    system_shared_memory_region& operator=(system_shared_memory_region&& other) noexcept;
+    system_shared_memory_region(const system_shared_memory_region&) = delete;
+    system_shared_memory_region& operator=(const system_shared_memory_region&) = delete;
+
+    [[nodiscard]]
+    inline const std::string& key() const noexcept
+    {
+        return _key;
+    }
+
+    [[nodiscard]]
+    inline size_t byte_size() const noexcept
+    {
+        return _byte_size;
+    }
+
+    [[nodiscard]]
+    inline std::byte* data() const noexcept
+    {
+        return _data;
+    }
+
+    [[nodiscard]]
+    inline std::span<std::byte> bytes(size_t offset, size_t byte_size) const noexcept
+    {
+        return std::span<std::byte>(_data + offset, byte_size);
+    }
+
+private:
+    void release() noexcept;
+
+    std::string _key;
+    size_t _byte_size = 0;
+    std::byte* _data = nullptr;
+};
+
+}
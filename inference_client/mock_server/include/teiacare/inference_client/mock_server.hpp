@@ -0,0 +1,101 @@
+#pragma once
+
+#include <teiacare/inference_client/async_client_interface.hpp>
+#include <teiacare/inference_client/client_interface.hpp>
+#include <teiacare/inference_client/client_options.hpp>
+#include <teiacare/inference_client/data_type.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace grpc
+{
+class Channel;
+}
+
+namespace tc::infer::mock
+{
+enum class model_kind
+{
+    // OUTPUT0 = INPUT0 + INPUT1 and OUTPUT1 = INPUT0 - INPUT1, as the Triton simple models (INT32 and FP32 only)
+    add_sub,
+
+    // Every input is returned as is, OUTPUTi for the i-th input, whatever its data type and shape
+    echo,
+
+    // Answers as echo, but the streams sending it a request are closed with UNAVAILABLE, as a server going away
+    close_stream
+};
+
+struct model_config
+{
+    std::string name;
+    model_kind kind = model_kind::echo;
+
+    // Declared by the model metadata, -1 dimensions are dynamic. The add_sub inputs must match them
+    tc::infer::data_type datatype = tc::infer::data_type::Fp32;
+    std::vector<int64_t> shape = { -1, -1 };
+
+    // Time spent by each inference of the model, on top of the server service time
+    std::chrono::microseconds service_time = std::chrono::microseconds(0);
+};
+
+struct mock_server_options
+{
+    // Listening address (e.g. "localhost:0" for any free port), when empty the server is only reachable in-process
+    std::string address = {};
+
+    // Time spent by each inference before answering, to model the server compute time
+    std::chrono::microseconds service_time = std::chrono::microseconds(0);
+
+    std::vector<model_config> models = {
+        { "simple_int32", model_kind::add_sub, tc::infer::data_type::Int32, { -1, 16 } },
+        { "simple_fp32", model_kind::add_sub, tc::infer::data_type::Fp32, { -1, 16 } },
+        { "echo", model_kind::echo, tc::infer::data_type::Fp32, { -1, -1 } },
+    };
+};
+
+// KServe GRPCInferenceService implementation serving the configured models without any network hop (in-process channels)
+// or on a local port, so that the client tests and benchmarks do not need a Triton server.
+// Inputs and requested outputs can be bound to registered POSIX shared memory regions
+class mock_server
+{
+public:
+    explicit mock_server(const mock_server_options& options = {});
+    ~mock_server();
+
+    mock_server(const mock_server&) = delete;
+    mock_server& operator=(const mock_server&) = delete;
+
+    // "host:port" for the clients created by tc::infer::create_client, empty for in-process servers
+    [[nodiscard]]
+    std::string uri() const;
+
+    // Clients connected through in-process channels (client_options::channel_pool_size channels)
+    [[nodiscard]]
+    std::unique_ptr<tc::infer::client_interface> create_client(const tc::infer::client_options& options = {});
+
+    [[nodiscard]]
+    std::unique_ptr<tc::infer::async_client_interface> create_async_client(const tc::infer::client_options& options = {});
+
+    // In-process channel for the clients built directly on the gRPC stubs or channels
+    [[nodiscard]]
+    std::shared_ptr<grpc::Channel> in_process_channel() const;
+
+    void set_service_time(std::chrono::microseconds service_time);
+
+    [[nodiscard]]
+    uint64_t infer_count() const;
+
+    [[nodiscard]]
+    uint64_t metadata_count() const;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> _impl;
+};
+
+}
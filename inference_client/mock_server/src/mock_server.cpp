@@ -0,0 +1,563 @@
+#include <teiacare/inference_client/mock_server.hpp>
+#include "batching_client.hpp"
+#include "grpc_client.hpp"
+#include "grpc_client_async.hpp"
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+#include <services.grpc.pb.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace tc::infer::mock
+{
+namespace
+{
+bool shape_matches(const google::protobuf::RepeatedField<int64_t>& shape, const std::vector<int64_t>& expected)
+{
+    return static_cast<size_t>(shape.size()) == expected.size() && std::equal(shape.begin(), shape.end(), expected.begin(), [](int64_t dim, int64_t expected_dim) { return expected_dim == -1 || dim == expected_dim; });
+}
+
+size_t element_count(const google::protobuf::RepeatedField<int64_t>& shape)
+{
+    return std::accumulate(shape.begin(), shape.end(), size_t{1}, [](size_t count, int64_t dim) { return count * static_cast<size_t>(dim); });
+}
+
+bool in_shared_memory(const google::protobuf::Map<std::string, inference::InferParameter>& parameters)
+{
+    return parameters.contains("shared_memory_region");
+}
+
+// Copy of the typed contents of the input (INT32 and FP32 only, the add_sub data types)
+std::string typed_input_bytes(const inference::ModelInferRequest_InferInputTensor& input)
+{
+    const inference::InferTensorContents& contents = input.contents();
+    if (input.datatype() == "INT32")
+        return std::string(reinterpret_cast<const char*>(contents.int_contents().data()), contents.int_contents().size() * sizeof(int32_t));
+
+    return std::string(reinterpret_cast<const char*>(contents.fp32_contents().data()), contents.fp32_contents().size() * sizeof(float));
+}
+
+template<typename T>
+void add_sub(const std::string& input0, const std::string& input1, std::string& sum, std::string& difference)
+{
+    const size_t size = input0.size() / sizeof(T);
+    sum.resize(input0.size());
+    difference.resize(input0.size());
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        T lhs, rhs;
+        std::memcpy(&lhs, input0.data() + i * sizeof(T), sizeof(T));
+        std::memcpy(&rhs, input1.data() + i * sizeof(T), sizeof(T));
+
+        const T lhs_plus_rhs = lhs + rhs;
+        const T lhs_minus_rhs = lhs - rhs;
+        std::memcpy(sum.data() + i * sizeof(T), &lhs_plus_rhs, sizeof(T));
+        std::memcpy(difference.data() + i * sizeof(T), &lhs_minus_rhs, sizeof(T));
+    }
+}
+
+class mock_service final : public inference::GRPCInferenceService::Service
+{
+public:
+    explicit mock_service(const mock_server_options& options)
+        : _service_time_us{ options.service_time.count() }
+    {
+        for (const model_config& model : options.models)
+        {
+            _models.try_emplace(model.name, model);
+        }
+    }
+
+    grpc::Status ServerLive(grpc::ServerContext*, const inference::ServerLiveRequest*, inference::ServerLiveResponse* response) override
+    {
+        response->set_live(true);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ServerReady(grpc::ServerContext*, const inference::ServerReadyRequest*, inference::ServerReadyResponse* response) override
+    {
+        response->set_ready(true);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ServerMetadata(grpc::ServerContext*, const inference::ServerMetadataRequest*, inference::ServerMetadataResponse* response) override
+    {
+        response->set_name("teiacare_mock_server");
+        response->set_version("1");
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ModelReady(grpc::ServerContext*, const inference::ModelReadyRequest* request, inference::ModelReadyResponse* response) override
+    {
+        response->set_ready(find_model(request->name()) != nullptr);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ModelList(grpc::ServerContext*, const inference::ModelListRequest*, inference::ModelListResponse* response) override
+    {
+        for (auto&& [name, model] : _models)
+        {
+            response->add_models(name);
+        }
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ModelMetadata(grpc::ServerContext*, const inference::ModelMetadataRequest* request, inference::ModelMetadataResponse* response) override
+    {
+        ++_metadata_count;
+        const model_config* model = find_model(request->name());
+        if (!model)
+            return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown model '" + request->name() + "'");
+
+        response->set_name(model->name);
+        response->add_versions("1");
+        response->set_platform("mock");
+
+        const int num_inputs = model->kind == model_kind::add_sub ? 2 : 1;
+        for (int i = 0; i < num_inputs; ++i)
+        {
+            set_tensor_metadata(response->add_inputs(), "INPUT" + std::to_string(i), *model);
+            set_tensor_metadata(response->add_outputs(), "OUTPUT" + std::to_string(i), *model);
+        }
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ModelLoad(grpc::ServerContext*, const inference::ModelLoadRequest* request, inference::ModelLoadResponse*) override
+    {
+        return set_loaded(request->name(), true);
+    }
+
+    grpc::Status ModelUnload(grpc::ServerContext*, const inference::ModelUnloadRequest* request, inference::ModelUnloadResponse*) override
+    {
+        return set_loaded(request->name(), false);
+    }
+
+    grpc::Status ModelInfer(grpc::ServerContext*, const inference::ModelInferRequest* request, inference::ModelInferResponse* response) override
+    {
+        return infer(*request, response);
+    }
+
+    grpc::Status ModelStreamInfer(grpc::ServerContext*, grpc::ServerReaderWriter<inference::ModelStreamInferResponse, inference::ModelInferRequest>* stream) override
+    {
+        inference::ModelInferRequest request;
+        while (stream->Read(&request))
+        {
+            if (const model_config* model = find_model(request.model_name()); model && model->kind == model_kind::close_stream)
+                return grpc::Status(grpc::StatusCode::UNAVAILABLE, "stream closed by model '" + model->name + "'");
+
+            inference::ModelStreamInferResponse response;
+            const grpc::Status status = infer(request, response.mutable_infer_response());
+            if (!status.ok())
+            {
+                response.set_error_message(status.error_message());
+                response.mutable_infer_response()->set_id(request.id());
+            }
+            stream->Write(response);
+        }
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SystemSharedMemoryRegister(grpc::ServerContext*, const inference::SystemSharedMemoryRegisterRequest* request, inference::SystemSharedMemoryRegisterResponse*) override
+    {
+        std::lock_guard lock(_regions_mutex);
+        if (_regions.contains(request->name()))
+            return grpc::Status(grpc::StatusCode::ALREADY_EXISTS, "shared memory region '" + request->name() + "' already registered");
+
+        auto& region = _regions[request->name()];
+        region.set_name(request->name());
+        region.set_key(request->key());
+        region.set_offset(request->offset());
+        region.set_byte_size(request->byte_size());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SystemSharedMemoryUnregister(grpc::ServerContext*, const inference::SystemSharedMemoryUnregisterRequest* request, inference::SystemSharedMemoryUnregisterResponse*) override
+    {
+        std::lock_guard lock(_regions_mutex);
+        if (request->name().empty())
+            _regions.clear();
+        else
+            _regions.erase(request->name());
+
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SystemSharedMemoryStatus(grpc::ServerContext*, const inference::SystemSharedMemoryStatusRequest* request, inference::SystemSharedMemoryStatusResponse* response) override
+    {
+        std::lock_guard lock(_regions_mutex);
+        for (auto&& [name, region] : _regions)
+        {
+            if (request->name().empty() || request->name() == name)
+                (*response->mutable_regions())[name] = region;
+        }
+        return grpc::Status::OK;
+    }
+
+    void set_service_time(std::chrono::microseconds service_time)
+    {
+        _service_time_us = service_time.count();
+    }
+
+    uint64_t infer_count() const
+    {
+        return _infer_count;
+    }
+
+    uint64_t metadata_count() const
+    {
+        return _metadata_count;
+    }
+
+private:
+    using parameters_map = google::protobuf::Map<std::string, inference::InferParameter>;
+
+    // The models are fixed at construction, only their loaded state changes
+    struct model_state
+    {
+        explicit model_state(const model_config& model_config) : config{ model_config } {}
+
+        const model_config config;
+        std::atomic<bool> loaded = true;
+    };
+
+    static void set_tensor_metadata(inference::ModelMetadataResponse_TensorMetadata* tensor, const std::string& name, const model_config& model)
+    {
+        tensor->set_name(name);
+        tensor->set_datatype(model.datatype.str());
+        for (int64_t dim : model.shape)
+        {
+            tensor->add_shape(dim);
+        }
+    }
+
+    const model_config* find_model(const std::string& name) const
+    {
+        const auto model = _models.find(name);
+        if (model == _models.end() || !model->second.loaded)
+            return nullptr;
+
+        return &model->second.config;
+    }
+
+    grpc::Status set_loaded(const std::string& name, bool loaded)
+    {
+        const auto model = _models.find(name);
+        if (model == _models.end())
+            return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown model '" + name + "'");
+
+        model->second.loaded = loaded;
+        return grpc::Status::OK;
+    }
+
+    grpc::Status infer(const inference::ModelInferRequest& request, inference::ModelInferResponse* response)
+    {
+        ++_infer_count;
+
+        const model_config* model = find_model(request.model_name());
+        if (!model)
+            return grpc::Status(grpc::StatusCode::NOT_FOUND, "unknown or unloaded model '" + request.model_name() + "'");
+
+        if (const int64_t service_time_us = _service_time_us + model->service_time.count(); service_time_us > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(service_time_us));
+
+        response->set_model_name(request.model_name());
+        response->set_model_version(request.model_version());
+        response->set_id(request.id());
+
+        const grpc::Status status = model->kind == model_kind::add_sub ? add_sub_model(*model, request, response) : echo_model(request, response);
+        if (!status.ok() || request.outputs_size() == 0)
+            return status;
+
+        return filter_outputs(request, response);
+    }
+
+    // Maps the registered region referenced by the shared memory parameters, as a local server would do
+    template<typename AccessT>
+    grpc::Status access_shared_memory(const parameters_map& parameters, AccessT access)
+    {
+        inference::SystemSharedMemoryStatusResponse::RegionStatus region;
+        {
+            std::lock_guard lock(_regions_mutex);
+            const auto registered = _regions.find(parameters.at("shared_memory_region").string_param());
+            if (registered == _regions.end())
+                return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "unregistered shared memory region '" + parameters.at("shared_memory_region").string_param() + "'");
+
+            region = registered->second;
+        }
+
+        const size_t offset = region.offset() + (parameters.contains("shared_memory_offset") ? parameters.at("shared_memory_offset").int64_param() : 0);
+        const size_t byte_size = parameters.at("shared_memory_byte_size").int64_param();
+        const size_t mapped_size = region.offset() + region.byte_size();
+        if (offset + byte_size > mapped_size)
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "out of bounds access to shared memory region '" + region.name() + "'");
+
+        const int fd = ::shm_open(region.key().c_str(), O_RDWR, 0);
+        if (fd == -1)
+            return grpc::Status(grpc::StatusCode::INTERNAL, "unable to open shared memory '" + region.key() + "'");
+
+        void* data = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return grpc::Status(grpc::StatusCode::INTERNAL, "unable to map shared memory '" + region.key() + "'");
+
+        access(static_cast<char*>(data) + offset, byte_size);
+        ::munmap(data, mapped_size);
+        return grpc::Status::OK;
+    }
+
+    // Bytes of every input, read from their raw contents, shared memory regions or typed contents
+    grpc::Status input_bytes(const inference::ModelInferRequest& request, std::vector<std::string>& inputs)
+    {
+        int raw_input_index = 0;
+        for (const auto& input : request.inputs())
+        {
+            std::string& bytes = inputs.emplace_back();
+            if (in_shared_memory(input.parameters()))
+            {
+                const grpc::Status status = access_shared_memory(input.parameters(), [&](const char* data, size_t byte_size) { bytes.assign(data, byte_size); });
+                if (!status.ok())
+                    return status;
+            }
+            else if (raw_input_index < request.raw_input_contents_size())
+            {
+                bytes = request.raw_input_contents(raw_input_index++);
+            }
+            else
+            {
+                bytes = typed_input_bytes(input);
+            }
+        }
+        return grpc::Status::OK;
+    }
+
+    grpc::Status add_sub_model(const model_config& model, const inference::ModelInferRequest& request, inference::ModelInferResponse* response)
+    {
+        if (request.inputs_size() != 2)
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "expected 2 inputs for model '" + model.name + "'");
+
+        const std::string datatype = model.datatype.str();
+        for (const auto& input : request.inputs())
+        {
+            if (input.datatype() != datatype || !shape_matches(input.shape(), model.shape))
+                return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "unexpected data type or shape for input '" + input.name() + "'");
+        }
+
+        std::vector<std::string> inputs;
+        if (const grpc::Status status = input_bytes(request, inputs); !status.ok())
+            return status;
+
+        const int input0_index = request.inputs(0).name() == "INPUT0" ? 0 : 1;
+        const std::string& input0 = inputs[input0_index];
+        const std::string& input1 = inputs[1 - input0_index];
+        if (input0.size() != input1.size() || input0.size() != element_count(request.inputs(input0_index).shape()) * model.datatype.element_size())
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "unexpected input byte size");
+
+        std::string sum, difference;
+        if (model.datatype == tc::infer::data_type::Int32)
+            add_sub<int32_t>(input0, input1, sum, difference);
+        else if (model.datatype == tc::infer::data_type::Fp32)
+            add_sub<float>(input0, input1, sum, difference);
+        else
+            return grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "add_sub models support INT32 and FP32 only");
+
+        for (const char* name : { "OUTPUT0", "OUTPUT1" })
+        {
+            auto* output = response->add_outputs();
+            output->set_name(name);
+            output->set_datatype(datatype);
+            *output->mutable_shape() = request.inputs(input0_index).shape();
+        }
+        response->add_raw_output_contents(std::move(sum));
+        response->add_raw_output_contents(std::move(difference));
+        return grpc::Status::OK;
+    }
+
+    grpc::Status echo_model(const inference::ModelInferRequest& request, inference::ModelInferResponse* response)
+    {
+        // Typed contents are echoed as typed contents, whatever their data type
+        const bool raw_input_contents = request.raw_input_contents_size() > 0 || std::any_of(request.inputs().begin(), request.inputs().end(), [](auto&& input) { return in_shared_memory(input.parameters()); });
+
+        std::vector<std::string> inputs;
+        if (raw_input_contents)
+        {
+            if (const grpc::Status status = input_bytes(request, inputs); !status.ok())
+                return status;
+        }
+
+        for (int i = 0; i < request.inputs_size(); ++i)
+        {
+            auto* output = response->add_outputs();
+            output->set_name("OUTPUT" + std::to_string(i));
+            output->set_datatype(request.inputs(i).datatype());
+            *output->mutable_shape() = request.inputs(i).shape();
+
+            if (raw_input_contents)
+                response->add_raw_output_contents(std::move(inputs[i]));
+            else
+                *output->mutable_contents() = request.inputs(i).contents();
+        }
+        return grpc::Status::OK;
+    }
+
+    // Keeps the requested outputs only, with their raw contents or written to their shared memory regions
+    grpc::Status filter_outputs(const inference::ModelInferRequest& request, inference::ModelInferResponse* response)
+    {
+        inference::ModelInferResponse filtered;
+        filtered.set_model_name(response->model_name());
+        filtered.set_model_version(response->model_version());
+        filtered.set_id(response->id());
+
+        for (const auto& requested : request.outputs())
+        {
+            const auto output = std::find_if(response->outputs().begin(), response->outputs().end(), [&](auto&& tensor) { return tensor.name() == requested.name(); });
+            if (output == response->outputs().end())
+                return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "unknown output '" + requested.name() + "'");
+
+            auto* filtered_output = filtered.add_outputs();
+            *filtered_output = *output;
+            const int index = static_cast<int>(std::distance(response->outputs().begin(), output));
+            if (in_shared_memory(requested.parameters()))
+            {
+                if (index >= response->raw_output_contents_size())
+                    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "shared memory output '" + requested.name() + "' requires raw input contents");
+
+                const std::string& contents = response->raw_output_contents(index);
+                const grpc::Status status = access_shared_memory(requested.parameters(), [&](char* data, size_t byte_size) { std::memcpy(data, contents.data(), std::min(byte_size, contents.size())); });
+                if (!status.ok())
+                    return status;
+
+                *filtered_output->mutable_parameters() = requested.parameters();
+            }
+            else if (index < response->raw_output_contents_size())
+            {
+                filtered.add_raw_output_contents(response->raw_output_contents(index));
+            }
+        }
+
+        *response = std::move(filtered);
+        return grpc::Status::OK;
+    }
+
+    std::atomic<int64_t> _service_time_us;
+    std::atomic<uint64_t> _infer_count = 0;
+    std::atomic<uint64_t> _metadata_count = 0;
+    std::map<std::string, model_state> _models;
+
+    std::mutex _regions_mutex;
+    std::map<std::string, inference::SystemSharedMemoryStatusResponse::RegionStatus> _regions;
+};
+
+}
+
+struct mock_server::impl
+{
+    explicit impl(const mock_server_options& options)
+        : service{ options }
+    {
+    }
+
+    std::shared_ptr<grpc::Channel> in_process_channel(unsigned channel_idx) const
+    {
+        grpc::ChannelArguments channel_args;
+        channel_args.SetMaxReceiveMessageSize(-1);
+        channel_args.SetInt("tc.channel_pool_index", static_cast<int>(channel_idx));
+        return server->InProcessChannel(channel_args);
+    }
+
+    std::vector<std::shared_ptr<grpc::ChannelInterface>> in_process_channels(unsigned channel_pool_size) const
+    {
+        std::vector<std::shared_ptr<grpc::ChannelInterface>> channels;
+        for (unsigned channel_idx = 0; channel_idx < std::max(channel_pool_size, 1u); ++channel_idx)
+        {
+            channels.push_back(in_process_channel(channel_idx));
+        }
+        return channels;
+    }
+
+    mock_service service;
+    std::unique_ptr<grpc::Server> server;
+    std::string uri;
+};
+
+mock_server::mock_server(const mock_server_options& options)
+    : _impl{ std::make_unique<impl>(options) }
+{
+    grpc::ServerBuilder builder;
+    builder.RegisterService(&_impl->service);
+    builder.SetMaxReceiveMessageSize(-1);
+    builder.SetMaxSendMessageSize(-1);
+
+    int port = 0;
+    if (!options.address.empty())
+        builder.AddListeningPort(options.address, grpc::InsecureServerCredentials(), &port);
+
+    _impl->server = builder.BuildAndStart();
+    if (!_impl->server || (!options.address.empty() && port == 0))
+        throw std::runtime_error("Unable to start the mock server on '" + options.address + "'");
+
+    if (!options.address.empty())
+        _impl->uri = options.address.substr(0, options.address.rfind(':')) + ":" + std::to_string(port);
+}
+
+mock_server::~mock_server()
+{
+    // Calls still in flight (e.g. streams whose owner outlives the server) are cancelled instead of waited for
+    _impl->server->Shutdown(std::chrono::system_clock::now() + std::chrono::seconds(1));
+}
+
+std::string mock_server::uri() const
+{
+    return _impl->uri;
+}
+
+std::unique_ptr<tc::infer::client_interface> mock_server::create_client(const tc::infer::client_options& options)
+{
+    const auto channels = _impl->in_process_channels(options.channel_pool_size);
+    auto client = std::make_unique<tc::infer::grpc_client>(channels, options);
+    if (options.dynamic_batching)
+        return std::make_unique<tc::infer::batching_client>(std::move(client), options);
+
+    return client;
+}
+
+std::unique_ptr<tc::infer::async_client_interface> mock_server::create_async_client(const tc::infer::client_options& options)
+{
+    const auto channels = _impl->in_process_channels(options.channel_pool_size);
+    return std::make_unique<tc::infer::grpc_client_async>(channels, options);
+}
+
+std::shared_ptr<grpc::Channel> mock_server::in_process_channel() const
+{
+    return _impl->in_process_channel(0);
+}
+
+void mock_server::set_service_time(std::chrono::microseconds service_time)
+{
+    _impl->service.set_service_time(service_time);
+}
+
+uint64_t mock_server::infer_count() const
+{
+    return _impl->service.infer_count();
+}
+
+uint64_t mock_server::metadata_count() const
+{
+    return _impl->service.metadata_count();
+}
+
+}
@@ -0,0 +1,281 @@
+#include "batching_client.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace tc::infer
+{
+batching_client::batching_client(std::unique_ptr<client_interface> client, const tc::infer::client_options& options)
+    : _client{ std::move(client) }
+    , _max_batch_size{ std::max<int64_t>(options.max_batch_size, 1) }
+    , _batching_window{ options.batching_window }
+{
+}
+
+bool batching_client::is_server_live()
+{
+    return _client->is_server_live();
+}
+
+bool batching_client::is_server_ready()
+{
+    return _client->is_server_ready();
+}
+
+tc::infer::server_metadata batching_client::server_metadata()
+{
+    return _client->server_metadata();
+}
+
+std::vector<std::string> batching_client::model_list()
+{
+    return _client->model_list();
+}
+
+bool batching_client::is_model_ready(const std::string& model_name, const std::string& model_version)
+{
+    return _client->is_model_ready(model_name, model_version);
+}
+
+bool batching_client::model_load(const std::string& model_name, const std::string& model_version)
+{
+    return _client->model_load(model_name, model_version);
+}
+
+bool batching_client::model_unload(const std::string& model_name, const std::string& model_version)
+{
+    return _client->model_unload(model_name, model_version);
+}
+
+tc::infer::model_metadata batching_client::model_metadata(const std::string& model_name, const std::string& model_version)
+{
+    return _client->model_metadata(model_name, model_version);
+}
+
+std::unique_ptr<tc::infer::infer_stream_interface> batching_client::create_infer_stream()
+{
+    return _client->create_infer_stream();
+}
+
+bool batching_client::system_shared_memory_register(const std::string& region_name, const std::string& key, size_t byte_size, size_t offset)
+{
+    return _client->system_shared_memory_register(region_name, key, byte_size, offset);
+}
+
+bool batching_client::system_shared_memory_unregister(const std::string& region_name)
+{
+    return _client->system_shared_memory_unregister(region_name);
+}
+
+std::vector<tc::infer::shared_memory_status> batching_client::system_shared_memory_status(const std::string& region_name)
+{
+    return _client->system_shared_memory_status(region_name);
+}
+
+tc::infer::client_statistics batching_client::statistics() const
+{
+    return _client->statistics();
+}
+
+tc::infer::infer_response batching_client::infer(const tc::infer::prepared_request& prepared_request, std::chrono::milliseconds infer_timeout)
+{
+    // Prepared requests are sent as they are, merging them would give up their cached encoding
+    return _client->infer(prepared_request, infer_timeout);
+}
+
+tc::infer::infer_response batching_client::infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout)
+{
+    const int64_t rows = batch_rows(infer_request);
+    if (rows <= 0 || rows >= _max_batch_size || !infer_request.requested_outputs.empty())
+        return _client->infer(infer_request, infer_timeout);
+
+    batch_entry entry { &infer_request, rows, infer_timeout, {} };
+    auto future = entry.promise.get_future();
+
+    batch_queue& queue = get_batch_queue(batch_key(infer_request));
+    std::unique_lock lock(queue.mutex);
+
+    if (queue.open_batch && queue.open_batch->rows + rows > _max_batch_size)
+    {
+        queue.open_batch->closed = true;
+        queue.open_batch->ready.notify_one();
+        queue.open_batch.reset();
+    }
+
+    if (queue.open_batch)
+    {
+        queue.open_batch->entries.push_back(&entry);
+        queue.open_batch->rows += rows;
+        if (queue.open_batch->rows >= _max_batch_size)
+            queue.open_batch->ready.notify_one();
+
+        lock.unlock();
+        return future.get();
+    }
+
+    // The first request of a batch waits for the others and sends the whole batch from its own thread
+    auto leader_batch = std::make_shared<batch>();
+    leader_batch->entries.push_back(&entry);
+    leader_batch->rows = rows;
+    queue.open_batch = leader_batch;
+
+    leader_batch->ready.wait_for(lock, _batching_window, [&] { return leader_batch->closed || leader_batch->rows >= _max_batch_size; });
+    if (queue.open_batch == leader_batch)
+        queue.open_batch.reset();
+
+    lock.unlock();
+
+    send_batch(*leader_batch);
+    return future.get();
+}
+
+int64_t batching_client::batch_rows(const tc::infer::infer_request& infer_request)
+{
+    // Requests are batchable when all their inputs have the same dimension 0 and a fixed size per row
+    if (infer_request.input_tensors.empty())
+        return 0;
+
+    const int64_t rows = infer_request.input_tensors.front().shape().empty() ? 0 : infer_request.input_tensors.front().shape().front();
+    for (const tc::infer::infer_tensor& input : infer_request.input_tensors)
+    {
+        const auto shape = input.shape();
+        if (shape.empty() || shape.front() != rows || input.datatype() == data_type::String || input.shared_memory())
+            return 0;
+    }
+
+    return rows;
+}
+
+std::string batching_client::batch_key(const tc::infer::infer_request& infer_request)
+{
+    std::string key = infer_request.model_name + '\0' + infer_request.model_version;
+    for (const tc::infer::infer_tensor& input : infer_request.input_tensors)
+    {
+        key += '\0' + input.name() + '\0';
+        key += input.datatype().name();
+        const auto shape = input.shape();
+        for (auto dim = shape.begin() + 1; dim != shape.end(); ++dim)
+        {
+            key += ',' + std::to_string(*dim);
+        }
+    }
+
+    return key;
+}
+
+auto batching_client::get_batch_queue(const std::string& key) -> batch_queue&
+{
+    std::lock_guard lock(_queues_mutex);
+    auto& queue = _queues[key];
+    if (!queue)
+        queue = std::make_unique<batch_queue>();
+
+    return *queue;
+}
+
+void batching_client::send_batch(const batch& batch)
+{
+    if (batch.entries.size() == 1)
+    {
+        batch_entry* entry = batch.entries.front();
+        try
+        {
+            entry->promise.set_value(_client->infer(*entry->request, entry->timeout));
+        }
+        catch(...)
+        {
+            entry->promise.set_exception(std::current_exception());
+        }
+        return;
+    }
+
+    try
+    {
+        const tc::infer::infer_request& first_request = *batch.entries.front()->request;
+        std::chrono::milliseconds batch_timeout { 0 };
+        for (const batch_entry* entry : batch.entries)
+        {
+            batch_timeout = std::max(batch_timeout, entry->timeout);
+        }
+
+        tc::infer::infer_request batch_request;
+        batch_request.model_name = first_request.model_name;
+        batch_request.model_version = first_request.model_version;
+
+        for (size_t input_idx = 0; input_idx < first_request.input_tensors.size(); ++input_idx)
+        {
+            size_t byte_size = 0;
+            for (const batch_entry* entry : batch.entries)
+            {
+                byte_size += entry->request->input_tensors[input_idx].byte_size();
+            }
+
+            std::vector<std::byte> data(byte_size);
+            std::byte* position = data.data();
+            for (const batch_entry* entry : batch.entries)
+            {
+                const tc::infer::infer_tensor& input = entry->request->input_tensors[input_idx];
+                std::memcpy(position, input.raw_data(), input.byte_size());
+                position += input.byte_size();
+            }
+
+            const tc::infer::infer_tensor& first_input = first_request.input_tensors[input_idx];
+            auto shape = first_input.shape();
+            shape.front() = batch.rows;
+            batch_request.input_tensors.emplace_back(std::move(data), std::move(shape), first_input.datatype(), first_input.name());
+        }
+
+        const tc::infer::infer_response batch_response = _client->infer(batch_request, batch_timeout);
+
+        std::vector<tc::infer::infer_response> responses(batch.entries.size());
+        for (size_t entry_idx = 0; entry_idx < batch.entries.size(); ++entry_idx)
+        {
+            responses[entry_idx].model_name = batch_response.model_name;
+            responses[entry_idx].model_version = batch_response.model_version;
+            responses[entry_idx].id = batch.entries[entry_idx]->request->id;
+            responses[entry_idx].output_tensors.reserve(batch_response.output_tensors.size());
+        }
+
+        // Every caller receives a slice of the batch output tensors, aliasing the batch response buffers
+        for (const tc::infer::infer_tensor& output : batch_response.output_tensors)
+        {
+            const auto shape = output.shape();
+            if (shape.empty() || shape.front() != batch.rows || output.datatype() == data_type::String || output.byte_size() % batch.rows != 0)
+                throw std::runtime_error("Unable to split output tensor '" + output.name() + "' of a batched request along dimension 0");
+
+            const size_t row_byte_size = output.byte_size() / batch.rows;
+            size_t offset = 0;
+            for (size_t entry_idx = 0; entry_idx < batch.entries.size(); ++entry_idx)
+            {
+                const int64_t rows = batch.entries[entry_idx]->rows;
+                const size_t byte_size = rows * row_byte_size;
+                auto entry_shape = shape;
+                entry_shape.front() = rows;
+
+                responses[entry_idx].add_output_tensor(tc::infer::infer_tensor(
+                    std::shared_ptr<const std::byte>(output.shared_data(), output.raw_data() + offset),
+                    byte_size,
+                    std::move(entry_shape),
+                    output.datatype(),
+                    output.name()));
+
+                offset += byte_size;
+            }
+        }
+
+        for (size_t entry_idx = 0; entry_idx < batch.entries.size(); ++entry_idx)
+        {
+            batch.entries[entry_idx]->promise.set_value(std::move(responses[entry_idx]));
+        }
+    }
+    catch(...)
+    {
+        for (batch_entry* entry : batch.entries)
+        {
+            entry->promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <teiacare/inference_client/client_interface.hpp>
+#include <teiacare/inference_client/client_options.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tc::infer
+{
+// Decorator coalescing concurrent infer calls with compatible inputs (same model, version, input names, data types
+// and shapes but dimension 0) into a single request. The batch is sent by the thread of its first request,
+// the other callers are blocked until their slice of the output tensors is available.
+class batching_client final : public client_interface
+{
+public:
+    explicit batching_client(std::unique_ptr<client_interface> client, const tc::infer::client_options& options);
+
+    bool is_server_live() override;
+    bool is_server_ready() override;
+    tc::infer::server_metadata server_metadata() override;
+    std::vector<std::string> model_list() override;
+    bool is_model_ready(const std::string& model_name, const std::string& model_version) override;
+    bool model_load(const std::string& model_name, const std::string& model_version) override;
+    bool model_unload(const std::string& model_name, const std::string& model_version) override;
+    tc::infer::model_metadata model_metadata(const std::string& model_name, const std::string& model_version) override;
+    tc::infer::infer_response infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout) override;
+    tc::infer::infer_response infer(const tc::infer::prepared_request& prepared_request, std::chrono::milliseconds infer_timeout) override;
+    std::unique_ptr<tc::infer::infer_stream_interface> create_infer_stream() override;
+    bool system_shared_memory_register(const std::string& region_name, const std::string& key, size_t byte_size, size_t offset) override;
+    bool system_shared_memory_unregister(const std::string& region_name) override;
+    std::vector<tc::infer::shared_memory_status> system_shared_memory_status(const std::string& region_name) override;
+
+    // Statistics of the wrapped client: a batch is recorded as a single infer call
+    tc::infer::client_statistics statistics() const override;
+
+protected:
+    struct batch_entry
+    {
+        const tc::infer::infer_request* request;
+        int64_t rows;
+        std::chrono::milliseconds timeout;
+        std::promise<tc::infer::infer_response> promise;
+    };
+
+    struct batch
+    {
+        std::vector<batch_entry*> entries;
+        int64_t rows = 0;
+        bool closed = false;
+        std::condition_variable ready;
+    };
+
+    struct batch_queue
+    {
+        std::mutex mutex;
+        std::shared_ptr<batch> open_batch;
+    };
+
+    static int64_t batch_rows(const tc::infer::infer_request& infer_request);
+    static std::string batch_key(const tc::infer::infer_request& infer_request);
+
+    batch_queue& get_batch_queue(const std::string& key);
+    void send_batch(const batch& batch);
+
+private:
+    std::unique_ptr<client_interface> _client;
+    const int64_t _max_batch_size;
+    const std::chrono::microseconds _batching_window;
+
+    std::mutex _queues_mutex;
+    std::unordered_map<std::string, std::unique_ptr<batch_queue>> _queues;
+};
+
+}
@@ -0,0 +1,114 @@
+#include <teiacare/inference_client/bf16.hpp>
+#include "cpu_features.hpp"
+
+namespace tc::infer
+{
+namespace
+{
+#if defined(TC_INFER_X86_DISPATCH)
+// Same rounding of bf16::from_float, on 8 (AVX2) or 16 (AVX-512) lanes.
+// The vectorized kernels return the number of converted elements, the remaining ones are left to the scalar loop.
+TC_INFER_TARGET("avx2") __m256i round_to_bf16_avx2(__m256i bits) noexcept
+{
+    const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(0x7FFF)), lsb), 16);
+    const __m256i quiet_nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x40));
+    const __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+    return _mm256_blendv_epi8(rounded, quiet_nan, nan);
+}
+
+TC_INFER_TARGET("avx2") size_t float_to_bf16_avx2(const float* source, size_t size, bf16* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m256i low = round_to_bf16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+        const __m256i high = round_to_bf16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 8)));
+
+        // packus works within 128 bit lanes, the permutation restores the element order
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(low, high), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx2") size_t bf16_to_float_avx2(const bf16* source, size_t size, float* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256i widened = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_slli_epi32(widened, 16));
+    }
+    return i;
+}
+
+// The zero-masked shifts and conversions avoid the undefined source operand GCC 12 warns about (-Wmaybe-uninitialized)
+constexpr __mmask16 all_lanes = 0xFFFF;
+
+TC_INFER_TARGET("avx512f") size_t float_to_bf16_avx512(const float* source, size_t size, bf16* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m512i bits = _mm512_loadu_si512(source + i);
+        const __m512i lsb = _mm512_and_si512(_mm512_maskz_srli_epi32(all_lanes, bits, 16), _mm512_set1_epi32(1));
+        const __m512i rounded = _mm512_maskz_srli_epi32(all_lanes, _mm512_add_epi32(_mm512_add_epi32(bits, _mm512_set1_epi32(0x7FFF)), lsb), 16);
+        const __m512i quiet_nan = _mm512_or_si512(_mm512_maskz_srli_epi32(all_lanes, bits, 16), _mm512_set1_epi32(0x40));
+        const __mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(bits, _mm512_set1_epi32(0x7FFFFFFF)), _mm512_set1_epi32(0x7F800000));
+
+        const __m512i result = _mm512_mask_blend_epi32(nan, rounded, quiet_nan);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm512_maskz_cvtepi32_epi16(all_lanes, result));
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx512f") size_t bf16_to_float_avx512(const bf16* source, size_t size, float* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m512i widened = _mm512_maskz_cvtepu16_epi32(all_lanes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+        _mm512_storeu_si512(destination + i, _mm512_maskz_slli_epi32(all_lanes, widened, 16));
+    }
+    return i;
+}
+#endif
+
+}
+
+void float_to_bf16(const float* source, size_t size, bf16* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_X86_DISPATCH)
+    if (tc::infer::cpu::has_avx512f())
+        i = float_to_bf16_avx512(source, size, destination);
+    else if (tc::infer::cpu::has_avx2())
+        i = float_to_bf16_avx2(source, size, destination);
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = bf16(source[i]);
+    }
+}
+
+void bf16_to_float(const bf16* source, size_t size, float* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_X86_DISPATCH)
+    if (tc::infer::cpu::has_avx512f())
+        i = bf16_to_float_avx512(source, size, destination);
+    else if (tc::infer::cpu::has_avx2())
+        i = bf16_to_float_avx2(source, size, destination);
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = static_cast<float>(source[i]);
+    }
+}
+
+}
@@ -0,0 +1,100 @@
+#include "byte_buffer_reader.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace tc::infer
+{
+byte_buffer_reader::byte_buffer_reader(grpc::ByteBuffer& buffer)
+    : _slices{ std::make_shared<std::vector<grpc::Slice>>() }
+    , _remaining{ buffer.Length() }
+{
+    if (!buffer.Dump(_slices.get()).ok())
+        throw std::runtime_error("Unable to read the received message");
+
+    skip_empty_slices();
+}
+
+bool byte_buffer_reader::at_end() const noexcept
+{
+    return _slice_index == _slices->size();
+}
+
+size_t byte_buffer_reader::remaining_in_slice() const noexcept
+{
+    return (*_slices)[_slice_index].size() - _slice_offset;
+}
+
+void byte_buffer_reader::skip_empty_slices() noexcept
+{
+    while (_slice_index < _slices->size() && remaining_in_slice() == 0)
+    {
+        ++_slice_index;
+        _slice_offset = 0;
+    }
+}
+
+uint64_t byte_buffer_reader::read_varint()
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (at_end())
+            throw std::runtime_error("Truncated varint in the received message");
+
+        const auto byte = static_cast<uint8_t>((*_slices)[_slice_index].begin()[_slice_offset]);
+        ++_slice_offset;
+        --_remaining;
+        skip_empty_slices();
+
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+
+    throw std::runtime_error("Malformed varint in the received message");
+}
+
+std::shared_ptr<const std::byte> byte_buffer_reader::read_bytes(size_t byte_size)
+{
+    if (byte_size == 0)
+        return std::shared_ptr<const std::byte>(_slices, nullptr);
+
+    if (byte_size > _remaining)
+        throw std::runtime_error("Truncated field in the received message");
+
+    if (!at_end() && remaining_in_slice() >= byte_size)
+    {
+        const auto data = std::bit_cast<const std::byte*>((*_slices)[_slice_index].begin() + _slice_offset);
+        _slice_offset += byte_size;
+        _remaining -= byte_size;
+        skip_empty_slices();
+        return std::shared_ptr<const std::byte>(_slices, data);
+    }
+
+    auto gathered = std::make_shared<std::string>();
+    gathered->reserve(byte_size);
+    copy_bytes(byte_size, *gathered);
+    return std::shared_ptr<const std::byte>(gathered, std::bit_cast<const std::byte*>(gathered->data()));
+}
+
+void byte_buffer_reader::copy_bytes(size_t byte_size, std::string& destination)
+{
+    if (byte_size > _remaining)
+        throw std::runtime_error("Truncated field in the received message");
+
+    while (byte_size > 0)
+    {
+
+        const size_t chunk = std::min(byte_size, remaining_in_slice());
+        destination.append(std::bit_cast<const char*>((*_slices)[_slice_index].begin() + _slice_offset), chunk);
+        _slice_offset += chunk;
+        _remaining -= chunk;
+        byte_size -= chunk;
+        skip_empty_slices();
+    }
+}
+
+}
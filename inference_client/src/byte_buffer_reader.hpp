@@ -0,0 +1,46 @@
+#pragma once
+
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tc::infer
+{
+// Sequential reader of the protobuf wire format over the slices of a received grpc::ByteBuffer.
+// The slices are referenced (not copied) and stay alive as long as any pointer returned by read_bytes.
+class byte_buffer_reader
+{
+public:
+    explicit byte_buffer_reader(grpc::ByteBuffer& buffer);
+
+    [[nodiscard]]
+    bool at_end() const noexcept;
+
+    [[nodiscard]]
+    uint64_t read_varint();
+
+    // Length-delimited payload: aliases the slice when it is contained in a single slice, otherwise it is gathered in one copy
+    [[nodiscard]]
+    std::shared_ptr<const std::byte> read_bytes(size_t byte_size);
+
+    void copy_bytes(size_t byte_size, std::string& destination);
+
+private:
+    [[nodiscard]]
+    size_t remaining_in_slice() const noexcept;
+    void skip_empty_slices() noexcept;
+
+    std::shared_ptr<std::vector<grpc::Slice>> _slices;
+    size_t _slice_index = 0;
+    size_t _slice_offset = 0;
+
+    // Bytes not consumed yet, so that an untrusted length is checked before anything is allocated for it
+    size_t _remaining = 0;
+};
+
+}
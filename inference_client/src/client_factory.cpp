@@ -1,14 +1,53 @@
 #include <teiacare/inference_client/client_factory.hpp>
+#include "batching_client.hpp"
 #include "grpc_client.hpp"
+#include "grpc_client_async.hpp"
 #include <grpcpp/create_channel.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include <algorithm>
 
 namespace tc::infer
 {
+namespace
+{
+std::vector<std::shared_ptr<grpc::ChannelInterface>> create_channels(const std::string& uri, const client_options& options)
+{
+	const unsigned channel_pool_size = std::max(options.channel_pool_size, 1u);
+	std::vector<std::shared_ptr<grpc::ChannelInterface>> channels;
+	channels.reserve(channel_pool_size);
+
+	for (unsigned channel_idx = 0; channel_idx < channel_pool_size; ++channel_idx)
+	{
+		// Channels with different arguments and a local subchannel pool never share their subchannel (i.e. their connection)
+		grpc::ChannelArguments channel_args;
+		channel_args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+		channel_args.SetInt("tc.channel_pool_index", static_cast<int>(channel_idx));
+
+		channels.push_back(grpc::CreateCustomChannel(uri, grpc::InsecureChannelCredentials(), channel_args));
+	}
+
+	return channels;
+}
+}
+
 std::unique_ptr<client_interface> create_client(const std::string& uri, std::chrono::milliseconds rpc_timeout) 
 {
-	std::shared_ptr<grpc::ChannelInterface> channel = grpc::CreateChannel(uri, grpc::InsecureChannelCredentials());
-	std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub = inference::GRPCInferenceService::NewStub(channel);
-	return std::make_unique<tc::infer::grpc_client>(std::move(stub), rpc_timeout);
+	return create_client(uri, client_options{ .rpc_timeout = rpc_timeout });
+}
+
+std::unique_ptr<client_interface> create_client(const std::string& uri, const client_options& options)
+{
+	auto client = std::make_unique<tc::infer::grpc_client>(create_channels(uri, options), options);
+	if (options.dynamic_batching)
+		return std::make_unique<tc::infer::batching_client>(std::move(client), options);
+
+	return client;
+}
+
+std::unique_ptr<async_client_interface> create_async_client(const std::string& uri, const client_options& options)
+{
+	return std::make_unique<tc::infer::grpc_client_async>(create_channels(uri, options), options);
 }
 
 // #if defined(UNIT_TESTS)
@@ -1,46 +1,57 @@
 #pragma once
 
+#include "protobuf_arena.hpp"
+#include "stub_pool.hpp"
+
 #include <grpcpp/client_context.h>
+#include <grpcpp/support/async_unary_call.h>
+#include <grpcpp/support/status.h>
+
 #include <functional>
+#include <memory>
 
 namespace tc::infer
 {
 
 struct AsyncClientCall
 {
+    virtual ~AsyncClientCall() = default;
+
     grpc::ClientContext context;
     grpc::Status result_code;
+    tc::infer::stub_pool::lease stub;
+
+    // Returns false when the call is completed and its tag can be released
     virtual bool proceed(bool ok) = 0;
 };
 
 template<class ResponseT>
 struct AsyncClientCallback : public AsyncClientCall
 {
-    ResponseT response;
-    void set_response_callback(std::function<void(ResponseT)> response_callback) { _on_response_callback = response_callback; }
+    using response_callback = std::function<void(std::shared_ptr<ResponseT>, const grpc::Status&)>;
+
+    std::shared_ptr<ResponseT> response = tc::infer::make_arena_message<ResponseT>();
+    void set_response_callback(response_callback on_response_callback) { _on_response_callback = std::move(on_response_callback); }
 
 protected:
-    std::function<void(ResponseT)> _on_response_callback;
+    response_callback _on_response_callback;
 };
 
 template<class ResponseT>
 struct AsyncClientUnaryCall : public AsyncClientCallback<ResponseT>
 {
-    std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseT>> rpc;
+    std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<ResponseT>> rpc;
 
     bool proceed(bool ok) override
     {
-        if (ok)
+        if (!ok)
+        {
+            this->result_code = grpc::Status(grpc::StatusCode::CANCELLED, "Completion queue is shutting down");
+        }
+
+        if (this->_on_response_callback)
         {
-            if (this->result_code.ok())
-            {
-                // SPDLOG_INFO(this->response.message());
-                if (this->_on_response_callback) this->_on_response_callback(this->response);
-            }
-            else
-            {
-                // SPDLOG_INFO("RPC failed: (" << this->result_code.error_code() << ") " << this->result_code.error_message());
-            }
+            this->_on_response_callback(std::move(this->response), this->result_code);
         }
 
         return false;
@@ -0,0 +1,251 @@
+#include "client_statistics_recorder.hpp"
+
+#include <algorithm>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+
+namespace tc::infer
+{
+namespace
+{
+// Updated by a single thread: a relaxed load and store is enough, the snapshots only need untorn values
+class shard_counter
+{
+public:
+    void add(uint64_t value) noexcept
+    {
+        _value.store(_value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void set_max(uint64_t value) noexcept
+    {
+        if (value > _value.load(std::memory_order_relaxed))
+            _value.store(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    uint64_t load() const noexcept
+    {
+        return _value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> _value = 0;
+};
+
+struct shard_histogram
+{
+    std::array<shard_counter, latency_histogram::bucket_count> counts;
+    shard_counter count;
+    shard_counter sum;
+    shard_counter max;
+
+    void record(std::chrono::nanoseconds latency) noexcept
+    {
+        const auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+        counts[latency_histogram::bucket_index(latency.count())].add(1);
+        count.add(1);
+        sum.add(nanoseconds);
+        max.set_max(nanoseconds);
+    }
+
+    void merge_into(latency_histogram& histogram) const noexcept
+    {
+        for (size_t i = 0; i < latency_histogram::bucket_count; ++i)
+        {
+            histogram.counts[i] += counts[i].load();
+        }
+
+        histogram.count += count.load();
+        histogram.sum += std::chrono::nanoseconds(sum.load());
+        histogram.max = std::max(histogram.max, std::chrono::nanoseconds(max.load()));
+    }
+};
+
+struct model_counters
+{
+    shard_counter requests;
+    shard_counter successes;
+    std::array<shard_counter, model_statistics::status_code_count> failures_by_status;
+    shard_counter client_errors;
+    shard_counter bytes_sent;
+    shard_counter bytes_received;
+    shard_histogram latency;
+    shard_histogram rpc_latency;
+};
+
+using model_key = std::pair<std::string, std::string>;
+using model_key_view = std::pair<std::string_view, std::string_view>;
+
+// Looks the models up without building their key strings
+struct model_key_less
+{
+    using is_transparent = void;
+
+    template<typename L, typename R>
+    bool operator()(const L& lhs, const R& rhs) const noexcept
+    {
+        return model_key_view(lhs.first, lhs.second) < model_key_view(rhs.first, rhs.second);
+    }
+};
+
+std::atomic<uint64_t> next_recorder_id = 0;
+
+}
+
+struct client_statistics_recorder::shard
+{
+    // Taken exclusively by the owner thread to add a model, and shared by the snapshots. The owner thread reads the
+    // map without locking, as it is the only writer
+    mutable std::shared_mutex mutex;
+    std::map<model_key, model_counters, model_key_less> models;
+};
+
+client_statistics_recorder::client_statistics_recorder()
+    : _id{ next_recorder_id.fetch_add(1, std::memory_order_relaxed) }
+{
+}
+
+client_statistics_recorder::~client_statistics_recorder()
+{
+}
+
+client_statistics_recorder::shard& client_statistics_recorder::thread_shard()
+{
+    struct thread_shard_entry
+    {
+        uint64_t recorder_id;
+        std::weak_ptr<shard> owner;
+        shard* instance;
+    };
+
+    // Shards of the recorders used by this thread, owned by the recorders (a recorder id is never reused)
+    thread_local std::vector<thread_shard_entry> thread_shards;
+
+    for (const thread_shard_entry& entry : thread_shards)
+    {
+        if (entry.recorder_id == _id)
+            return *entry.instance;
+    }
+
+    std::erase_if(thread_shards, [](const thread_shard_entry& entry) { return entry.owner.expired(); });
+
+    auto new_shard = std::make_shared<shard>();
+    {
+        std::lock_guard lock(_shards_mutex);
+        _shards.push_back(new_shard);
+    }
+
+    thread_shards.push_back({ _id, new_shard, new_shard.get() });
+    return *new_shard;
+}
+
+void client_statistics_recorder::record(std::string_view model_name, std::string_view model_version, const infer_call& call)
+{
+    shard& thread_shard = this->thread_shard();
+
+    auto model = thread_shard.models.find(model_key_view(model_name, model_version));
+    if (model == thread_shard.models.end())
+    {
+        std::unique_lock lock(thread_shard.mutex);
+        model = thread_shard.models.try_emplace(model_key(model_name, model_version)).first;
+    }
+
+    model_counters& counters = model->second;
+    counters.requests.add(1);
+    counters.bytes_sent.add(call.bytes_sent);
+    counters.bytes_received.add(call.bytes_received);
+    counters.latency.record(call.latency);
+
+    if (call.status_code == client_error)
+    {
+        counters.client_errors.add(1);
+    }
+    else
+    {
+        counters.rpc_latency.record(call.rpc_latency);
+        if (call.status_code == grpc::StatusCode::OK)
+            counters.successes.add(1);
+        else if (call.status_code > 0 && static_cast<size_t>(call.status_code) < model_statistics::status_code_count)
+            counters.failures_by_status[static_cast<size_t>(call.status_code)].add(1);
+    }
+}
+
+tc::infer::client_statistics client_statistics_recorder::snapshot() const
+{
+    std::map<model_key, model_statistics> models;
+
+    std::lock_guard shards_lock(_shards_mutex);
+    for (const std::shared_ptr<shard>& shard : _shards)
+    {
+        std::shared_lock shard_lock(shard->mutex);
+        for (auto&& [key, counters] : shard->models)
+        {
+            model_statistics& statistics = models[key];
+            statistics.request_count += counters.requests.load();
+            statistics.success_count += counters.successes.load();
+            for (size_t i = 0; i < model_statistics::status_code_count; ++i)
+            {
+                statistics.failures_by_status[i] += counters.failures_by_status[i].load();
+            }
+            statistics.client_error_count += counters.client_errors.load();
+            statistics.bytes_sent += counters.bytes_sent.load();
+            statistics.bytes_received += counters.bytes_received.load();
+            counters.latency.merge_into(statistics.latency);
+            counters.rpc_latency.merge_into(statistics.rpc_latency);
+        }
+    }
+
+    tc::infer::client_statistics client_statistics;
+    client_statistics.models.reserve(models.size());
+    for (auto&& [key, statistics] : models)
+    {
+        statistics.model_name = key.first;
+        statistics.model_version = key.second;
+        statistics.timeout_count = statistics.failures_by_status[grpc::StatusCode::DEADLINE_EXCEEDED];
+        client_statistics.models.push_back(std::move(statistics));
+    }
+
+    return client_statistics;
+}
+
+infer_call_statistics::infer_call_statistics(client_statistics_recorder& recorder, std::string_view model_name, std::string_view model_version) noexcept
+    : _recorder{ recorder }
+    , _model_name{ model_name }
+    , _model_version{ model_version }
+{
+}
+
+infer_call_statistics::~infer_call_statistics()
+{
+    // A call whose RPC succeeded can still fail while converting the response
+    if (_call.status_code == grpc::StatusCode::OK && std::uncaught_exceptions() > _uncaught_exceptions)
+        _call.status_code = client_statistics_recorder::client_error;
+
+    _call.latency = clock::now() - _start;
+    try
+    {
+        _recorder.record(_model_name, _model_version, _call);
+    }
+    catch (...)
+    {
+        // Statistics are best effort: a failed allocation never fails the infer call
+    }
+}
+
+void infer_call_statistics::rpc_started() noexcept
+{
+    _rpc_start = clock::now();
+}
+
+void infer_call_statistics::rpc_finished(const grpc::Status& rpc_status, uint64_t bytes_sent, uint64_t bytes_received) noexcept
+{
+    _call.rpc_latency = clock::now() - _rpc_start;
+    _call.status_code = rpc_status.error_code();
+    _call.bytes_sent = bytes_sent;
+    _call.bytes_received = bytes_received;
+}
+
+}
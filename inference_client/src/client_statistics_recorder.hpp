@@ -0,0 +1,81 @@
+#pragma once
+
+#include <teiacare/inference_client/client_statistics.hpp>
+
+#include <grpcpp/support/status.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace tc::infer
+{
+// Infer call statistics sharded per thread: each thread only updates the counters of its own shard (relaxed atomic
+// stores, without locks or read-modify-write instructions) and snapshot() merges the shards of all the threads
+class client_statistics_recorder
+{
+public:
+    static constexpr int client_error = -1;
+
+    struct infer_call
+    {
+        std::chrono::nanoseconds latency;
+        std::chrono::nanoseconds rpc_latency;
+
+        // grpc::StatusCode of the RPC, or client_error when the call failed in the client
+        int status_code;
+        uint64_t bytes_sent;
+        uint64_t bytes_received;
+    };
+
+    client_statistics_recorder();
+    ~client_statistics_recorder();
+
+    client_statistics_recorder(const client_statistics_recorder&) = delete;
+    client_statistics_recorder& operator=(const client_statistics_recorder&) = delete;
+
+    void record(std::string_view model_name, std::string_view model_version, const infer_call& call);
+
+    [[nodiscard]]
+    tc::infer::client_statistics snapshot() const;
+
+private:
+    struct shard;
+    shard& thread_shard();
+
+    const uint64_t _id;
+    mutable std::mutex _shards_mutex;
+    std::vector<std::shared_ptr<shard>> _shards;
+};
+
+// Records a synchronous infer call when destroyed, as a client error when it is left by an exception not raised by a failed RPC
+class infer_call_statistics
+{
+public:
+    infer_call_statistics(client_statistics_recorder& recorder, std::string_view model_name, std::string_view model_version) noexcept;
+    ~infer_call_statistics();
+
+    infer_call_statistics(const infer_call_statistics&) = delete;
+    infer_call_statistics& operator=(const infer_call_statistics&) = delete;
+
+    void rpc_started() noexcept;
+    void rpc_finished(const grpc::Status& rpc_status, uint64_t bytes_sent, uint64_t bytes_received) noexcept;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    client_statistics_recorder& _recorder;
+    std::string_view _model_name;
+    std::string_view _model_version;
+    const int _uncaught_exceptions = std::uncaught_exceptions();
+    const clock::time_point _start = clock::now();
+    clock::time_point _rpc_start = _start;
+    client_statistics_recorder::infer_call _call { {}, {}, client_statistics_recorder::client_error, 0, 0 };
+};
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// Runtime dispatch of the vectorized conversion kernels: the library is built for the x86-64 baseline,
+// the AVX2 / AVX-512 / F16C kernels are compiled with a target attribute and selected by the CPU features.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TC_INFER_X86_DISPATCH
+#define TC_INFER_TARGET(features) __attribute__((target(features)))
+
+namespace tc::infer::cpu
+{
+inline bool has_avx2() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+inline bool has_avx512f() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+inline bool has_f16c() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+    return supported;
+}
+
+}
+#endif
@@ -0,0 +1,94 @@
+#include <teiacare/inference_client/fp16.hpp>
+#include "cpu_features.hpp"
+
+namespace tc::infer
+{
+namespace
+{
+#if defined(TC_INFER_X86_DISPATCH)
+// The zero-masked AVX-512 conversions avoid the undefined source operand GCC 12 warns about (-Wmaybe-uninitialized)
+constexpr __mmask16 all_lanes = 0xFFFF;
+
+// The vectorized kernels return the number of converted elements, the remaining ones are left to the scalar loop
+TC_INFER_TARGET("avx512f") size_t float_to_fp16_avx512(const float* source, size_t size, fp16* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m256i half = _mm512_maskz_cvtps_ph(all_lanes, _mm512_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), half);
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx512f") size_t fp16_to_float_avx512(const fp16* source, size_t size, float* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m256i half = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        _mm512_storeu_ps(destination + i, _mm512_maskz_cvtph_ps(all_lanes, half));
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx,f16c") size_t float_to_fp16_f16c(const float* source, size_t size, fp16* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), half);
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx,f16c") size_t fp16_to_float_f16c(const fp16* source, size_t size, float* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(half));
+    }
+    return i;
+}
+#endif
+
+}
+
+void float_to_fp16(const float* source, size_t size, fp16* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_X86_DISPATCH)
+    if (tc::infer::cpu::has_avx512f())
+        i = float_to_fp16_avx512(source, size, destination);
+    else if (tc::infer::cpu::has_f16c())
+        i = float_to_fp16_f16c(source, size, destination);
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = fp16(source[i]);
+    }
+}
+
+void fp16_to_float(const fp16* source, size_t size, float* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_X86_DISPATCH)
+    if (tc::infer::cpu::has_avx512f())
+        i = fp16_to_float_avx512(source, size, destination);
+    else if (tc::infer::cpu::has_f16c())
+        i = fp16_to_float_f16c(source, size, destination);
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = static_cast<float>(source[i]);
+    }
+}
+
+}
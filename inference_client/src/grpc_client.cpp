@@ -1,15 +1,52 @@
 #include "grpc_client.hpp"
+#include "grpc_infer_stream.hpp"
+#include "protobuf_arena.hpp"
 #include <grpcpp/channel.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
 #include <grpcpp/support/status.h>
 
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
 namespace tc::infer
 {
-grpc_client::grpc_client(std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub, std::chrono::milliseconds rpc_timeout)
-    : _stub{ std::move(stub) }
-    , _tensor_converter{ std::make_unique<tc::infer::tensor_converter>() }
-    , _rpc_timeout{ rpc_timeout }
+namespace
+{
+std::pair<std::string_view, std::string_view> request_model(const tc::infer::infer_request& infer_request)
+{
+    return { infer_request.model_name, infer_request.model_version };
+}
+
+std::pair<std::string_view, std::string_view> request_model(const tc::infer::prepared_request& prepared_request)
+{
+    return { prepared_request.model_name(), prepared_request.model_version() };
+}
+
+}
+
+grpc_client::grpc_client(std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub, const tc::infer::client_options& options)
+    : grpc_client([&stub] { std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs; stubs.push_back(std::move(stub)); return stubs; }(), options)
+{
+}
+
+grpc_client::grpc_client(std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs, const tc::infer::client_options& options)
+    : _stubs{ std::move(stubs), options.channel_selection }
+    , _tensor_converter{ std::make_shared<tc::infer::tensor_converter>(options.raw_input_contents) }
+    , _rpc_timeout{ options.rpc_timeout }
+    , _metadata_cache{ options.model_metadata_cache ? std::make_unique<tc::infer::model_metadata_cache>(options.model_metadata_ttl) : nullptr }
+    , _statistics{ std::make_unique<tc::infer::client_statistics_recorder>() }
+{
+}
+
+grpc_client::grpc_client(const std::vector<std::shared_ptr<grpc::ChannelInterface>>& channels, const tc::infer::client_options& options)
+    : _stubs{ channels, options.channel_selection }
+    , _tensor_converter{ std::make_shared<tc::infer::tensor_converter>(options.raw_input_contents) }
+    , _rpc_timeout{ options.rpc_timeout }
+    , _metadata_cache{ options.model_metadata_cache ? std::make_unique<tc::infer::model_metadata_cache>(options.model_metadata_ttl) : nullptr }
+    , _statistics{ std::make_unique<tc::infer::client_statistics_recorder>() }
 {
 }
 
@@ -17,7 +54,7 @@ grpc_client::~grpc_client()
 {
 }
 
-void grpc_client::check_status(grpc::Status rpc_status) const
+void grpc_client::check_status(grpc::Status rpc_status)
 {
     switch(rpc_status.error_code())
     {
@@ -39,7 +76,7 @@ bool grpc_client::is_server_live()
     grpc::ClientContext context;
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    const grpc::Status rpc_status = _stub->ServerLive(&context, request, &response);
+    const grpc::Status rpc_status = _stubs.acquire()->ServerLive(&context, request, &response);
     check_status(rpc_status);
 
     return response.live();
@@ -52,7 +89,7 @@ bool grpc_client::is_server_ready()
     grpc::ClientContext context;
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    const grpc::Status rpc_status = _stub->ServerReady(&context, request, &response);
+    const grpc::Status rpc_status = _stubs.acquire()->ServerReady(&context, request, &response);
     check_status(rpc_status);
 
     return response.ready();
@@ -65,7 +102,7 @@ tc::infer::server_metadata grpc_client::server_metadata()
     grpc::ClientContext context;
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    grpc::Status rpc_status = _stub->ServerMetadata(&context, request, &response);
+    grpc::Status rpc_status = _stubs.acquire()->ServerMetadata(&context, request, &response);
     check_status(rpc_status);
 
     const std::vector<std::string> server_extensions = { response.extensions().begin(), response.extensions().end() };
@@ -84,7 +121,7 @@ bool grpc_client::is_model_ready(const std::string& model_name, const std::strin
     request.set_version(model_version);
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    grpc::Status rpc_status = _stub->ModelReady(&context, request, &response);
+    grpc::Status rpc_status = _stubs.acquire()->ModelReady(&context, request, &response);
     check_status(rpc_status);
 
     return response.ready();
@@ -97,7 +134,7 @@ std::vector<std::string> grpc_client::model_list()
     grpc::ClientContext context;
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    grpc::Status rpc_status = _stub->ModelList(&context, request, &response);
+    grpc::Status rpc_status = _stubs.acquire()->ModelList(&context, request, &response);
     check_status(rpc_status);
     
     const auto models = response.models();
@@ -115,9 +152,12 @@ bool grpc_client::model_load(const std::string& model_name, const std::string&)
     request.set_name(model_name);
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    grpc::Status rpc_status = _stub->ModelLoad(&context, request, &response);
+    grpc::Status rpc_status = _stubs.acquire()->ModelLoad(&context, request, &response);
     check_status(rpc_status);
 
+    if (_metadata_cache)
+        _metadata_cache->invalidate(model_name);
+
     return true;
 }
 
@@ -130,14 +170,28 @@ bool grpc_client::model_unload(const std::string& model_name, const std::string&
     request.set_name(model_name);
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    grpc::Status rpc_status = _stub->ModelUnload(&context, request, &response);
+    grpc::Status rpc_status = _stubs.acquire()->ModelUnload(&context, request, &response);
     check_status(rpc_status);
 
+    if (_metadata_cache)
+        _metadata_cache->invalidate(model_name);
+
     return true;
 }
 
 tc::infer::model_metadata grpc_client::model_metadata(const std::string& model_name, const std::string& model_version)
 {
+    return *fetch_model_metadata(model_name, model_version);
+}
+
+std::shared_ptr<const tc::infer::model_metadata> grpc_client::fetch_model_metadata(const std::string& model_name, const std::string& model_version)
+{
+    if (_metadata_cache)
+    {
+        if (auto cached = _metadata_cache->find(model_name, model_version))
+            return cached;
+    }
+
     inference::ModelMetadataRequest request;
     inference::ModelMetadataResponse response;
     grpc::ClientContext context;
@@ -146,9 +200,18 @@ tc::infer::model_metadata grpc_client::model_metadata(const std::string& model_n
     request.set_version(model_version);
 
     context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
-    grpc::Status rpc_status = _stub->ModelMetadata(&context, request, &response);
+    grpc::Status rpc_status = _stubs.acquire()->ModelMetadata(&context, request, &response);
     check_status(rpc_status);
 
+    auto metadata = std::make_shared<const tc::infer::model_metadata>(get_model_metadata(response));
+    if (_metadata_cache)
+        _metadata_cache->insert(model_name, model_version, metadata);
+
+    return metadata;
+}
+
+tc::infer::model_metadata grpc_client::get_model_metadata(const inference::ModelMetadataResponse& response)
+{
     tc::infer::model_metadata metadata;
     metadata.model_name = response.name();
     metadata.model_versions = std::vector<std::string>{ response.versions().begin(), response.versions().end() };
@@ -171,7 +234,41 @@ tc::infer::model_metadata grpc_client::model_metadata(const std::string& model_n
 
 tc::infer::infer_response grpc_client::infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout)
 {
-    inference::ModelInferResponse response;
+    return infer_call(infer_request, infer_timeout);
+}
+
+tc::infer::infer_response grpc_client::infer(const tc::infer::prepared_request& prepared_request, std::chrono::milliseconds infer_timeout)
+{
+    return infer_call(prepared_request, infer_timeout);
+}
+
+template<typename RequestT>
+void grpc_client::validate_request(const RequestT& infer_request, bool fetch_metadata)
+{
+    if (!_metadata_cache)
+        return;
+
+    std::shared_ptr<const tc::infer::model_metadata> metadata;
+    if constexpr (std::is_same_v<RequestT, tc::infer::prepared_request>)
+        metadata = fetch_metadata ? fetch_model_metadata(infer_request.model_name(), infer_request.model_version()) : _metadata_cache->find(infer_request.model_name(), infer_request.model_version());
+    else
+        metadata = fetch_metadata ? fetch_model_metadata(infer_request.model_name, infer_request.model_version) : _metadata_cache->find(infer_request.model_name, infer_request.model_version);
+
+    if (metadata)
+        tc::infer::model_metadata_cache::validate(*metadata, infer_request);
+}
+
+template void grpc_client::validate_request(const tc::infer::infer_request&, bool);
+template void grpc_client::validate_request(const tc::infer::prepared_request&, bool);
+
+template<typename RequestT>
+tc::infer::infer_response grpc_client::infer_call(const RequestT& infer_request, std::chrono::milliseconds infer_timeout)
+{
+    const auto [model_name, model_version] = request_model(infer_request);
+    tc::infer::infer_call_statistics call_statistics(*_statistics, model_name, model_version);
+
+    validate_request(infer_request, true);
+
     grpc::ClientContext context;
 
     std::map<std::string, std::string> metadata {};
@@ -179,15 +276,129 @@ tc::infer::infer_response grpc_client::infer(const tc::infer::infer_request& inf
     {
         context.AddMetadata(key, value);
     }
-    
-    auto request = _tensor_converter->get_infer_request(infer_request);
 
     context.set_deadline(std::chrono::system_clock::now() + infer_timeout);
-    grpc::Status rpc_status = _stub->ModelInfer(&context, request, &response);
+    auto stub = _stubs.acquire();
+
+    if (grpc::GenericStub* generic_stub = stub.generic_stub())
+    {
+        // Large raw inputs are sent straight from the tensors memory and raw outputs are sliced from the received buffer
+        const grpc::ByteBuffer request_buffer = _tensor_converter->get_infer_request_buffer(infer_request);
+        grpc::ByteBuffer response_buffer;
+        call_statistics.rpc_started();
+        const grpc::Status rpc_status = generic_unary_call(generic_stub, &context, model_infer_method, request_buffer, &response_buffer);
+        call_statistics.rpc_finished(rpc_status, request_buffer.Length(), response_buffer.Length());
+        check_status(rpc_status);
+        return _tensor_converter->get_infer_response(response_buffer);
+    }
+
+    // The request only lives for the call on the thread arena, the response arena is owned by the output tensors
+    tc::infer::thread_arena_scope arena_scope;
+    const inference::ModelInferRequest* request = _tensor_converter->get_infer_request(infer_request, arena_scope.arena());
+    auto response = tc::infer::make_arena_message<inference::ModelInferResponse>();
+    call_statistics.rpc_started();
+    const grpc::Status rpc_status = stub->ModelInfer(&context, *request, response.get());
+
+    // The request size was cached by its serialization, the response was parsed and has to be measured
+    call_statistics.rpc_finished(rpc_status, static_cast<uint64_t>(request->GetCachedSize()), rpc_status.ok() ? response->ByteSizeLong() : 0);
     check_status(rpc_status);
 
     auto infer_response = _tensor_converter->get_infer_response(response);
     return infer_response;
 }
 
+grpc::Status grpc_client::generic_unary_call(grpc::GenericStub* generic_stub, grpc::ClientContext* context, const std::string& method, const grpc::ByteBuffer& request, grpc::ByteBuffer* response)
+{
+    // Blocking call on a completion queue of its own, polled by the calling thread (as the generated blocking stubs do),
+    // without any thread hop or shared state with a callback
+    grpc::CompletionQueue completion_queue;
+    auto call = generic_stub->PrepareUnaryCall(context, method, request, &completion_queue);
+    call->StartCall();
+
+    grpc::Status rpc_status;
+    call->Finish(response, &rpc_status, &rpc_status);
+
+    void* tag = nullptr;
+    bool ok = false;
+    completion_queue.Next(&tag, &ok);
+
+    completion_queue.Shutdown();
+    while (completion_queue.Next(&tag, &ok))
+    {
+    }
+
+    return rpc_status;
 }
+
+std::unique_ptr<tc::infer::infer_stream_interface> grpc_client::create_infer_stream()
+{
+    return std::make_unique<tc::infer::grpc_infer_stream>(_stubs.acquire().shared_stub(), _tensor_converter, _rpc_timeout);
+}
+
+bool grpc_client::system_shared_memory_register(const std::string& region_name, const std::string& key, size_t byte_size, size_t offset)
+{
+    inference::SystemSharedMemoryRegisterRequest request;
+    inference::SystemSharedMemoryRegisterResponse response;
+    grpc::ClientContext context;
+
+    request.set_name(region_name);
+    request.set_key(key);
+    request.set_byte_size(byte_size);
+    request.set_offset(offset);
+
+    context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
+    grpc::Status rpc_status = _stubs.acquire()->SystemSharedMemoryRegister(&context, request, &response);
+    check_status(rpc_status);
+
+    return true;
+}
+
+bool grpc_client::system_shared_memory_unregister(const std::string& region_name)
+{
+    inference::SystemSharedMemoryUnregisterRequest request;
+    inference::SystemSharedMemoryUnregisterResponse response;
+    grpc::ClientContext context;
+
+    request.set_name(region_name);
+
+    context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
+    grpc::Status rpc_status = _stubs.acquire()->SystemSharedMemoryUnregister(&context, request, &response);
+    check_status(rpc_status);
+
+    return true;
+}
+
+std::vector<tc::infer::shared_memory_status> grpc_client::system_shared_memory_status(const std::string& region_name)
+{
+    inference::SystemSharedMemoryStatusRequest request;
+    inference::SystemSharedMemoryStatusResponse response;
+    grpc::ClientContext context;
+
+    request.set_name(region_name);
+
+    context.set_deadline(std::chrono::system_clock::now() + _rpc_timeout);
+    grpc::Status rpc_status = _stubs.acquire()->SystemSharedMemoryStatus(&context, request, &response);
+    check_status(rpc_status);
+
+    std::vector<tc::infer::shared_memory_status> regions;
+    regions.reserve(response.regions_size());
+    for (auto&& [name, region] : response.regions())
+    {
+        regions.push_back({ region.name(), region.key(), region.offset(), region.byte_size() });
+    }
+
+    return regions;
+}
+
+tc::infer::client_statistics grpc_client::statistics() const
+{
+    return _statistics->snapshot();
+}
+
+void grpc_client::record_client_error(const tc::infer::infer_request& infer_request, std::chrono::steady_clock::time_point start)
+{
+    const tc::infer::client_statistics_recorder::infer_call call { std::chrono::steady_clock::now() - start, {}, tc::infer::client_statistics_recorder::client_error, 0, 0 };
+    _statistics->record(infer_request.model_name, infer_request.model_version, call);
+}
+
+}
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include <grpcpp/support/status.h>
 #include <teiacare/inference_client/client_interface.hpp>
+#include <teiacare/inference_client/client_options.hpp>
 #include <services.grpc.pb.h>
+#include "client_statistics_recorder.hpp"
+#include "model_metadata_cache.hpp"
+#include "stub_pool.hpp"
 #include "tensor_converter.hpp"
 
 #include <vector>
@@ -12,10 +16,12 @@
 
 namespace tc::infer
 {
-class grpc_client : public client_interface
+class grpc_client : public virtual client_interface
 {
 public:
-    explicit grpc_client(std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub, std::chrono::milliseconds rpc_timeout);
+    explicit grpc_client(std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub, const tc::infer::client_options& options);
+    explicit grpc_client(std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs, const tc::infer::client_options& options);
+    explicit grpc_client(const std::vector<std::shared_ptr<grpc::ChannelInterface>>& channels, const tc::infer::client_options& options);
     ~grpc_client();
 
     bool is_server_live() override;
@@ -27,14 +33,38 @@ public:
     bool model_unload(const std::string& model_name, const std::string& model_version) override;
     tc::infer::model_metadata model_metadata(const std::string& model_name, const std::string& model_version) override;
     tc::infer::infer_response infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout) override;
+    tc::infer::infer_response infer(const tc::infer::prepared_request& prepared_request, std::chrono::milliseconds infer_timeout) override;
+    std::unique_ptr<tc::infer::infer_stream_interface> create_infer_stream() override;
+    bool system_shared_memory_register(const std::string& region_name, const std::string& key, size_t byte_size, size_t offset) override;
+    bool system_shared_memory_unregister(const std::string& region_name) override;
+    std::vector<tc::infer::shared_memory_status> system_shared_memory_status(const std::string& region_name) override;
+    tc::infer::client_statistics statistics() const override;
+
+    static void check_status(grpc::Status rpc_status);
 
 protected:
-    void check_status(grpc::Status rpc_status) const;
+    static constexpr const char* model_infer_method = "/inference.GRPCInferenceService/ModelInfer";
+
+    static grpc::Status generic_unary_call(grpc::GenericStub* generic_stub, grpc::ClientContext* context, const std::string& method, const grpc::ByteBuffer& request, grpc::ByteBuffer* response);
+    static tc::infer::model_metadata get_model_metadata(const inference::ModelMetadataResponse& response);
+
+    template<typename RequestT>
+    tc::infer::infer_response infer_call(const RequestT& infer_request, std::chrono::milliseconds infer_timeout);
+
+    // With the metadata cache enabled, fetch_metadata fetches the missing metadata instead of skipping the validation
+    template<typename RequestT>
+    void validate_request(const RequestT& infer_request, bool fetch_metadata);
+
+    std::shared_ptr<const tc::infer::model_metadata> fetch_model_metadata(const std::string& model_name, const std::string& model_version);
+
+    // Infer calls failed before being sent, recorded by the calls not covered by an infer_call_statistics scope
+    void record_client_error(const tc::infer::infer_request& infer_request, std::chrono::steady_clock::time_point start);
 
-private:
-    std::unique_ptr<inference::GRPCInferenceService::StubInterface> _stub;
-    std::unique_ptr<tc::infer::tensor_converter> _tensor_converter;
+    tc::infer::stub_pool _stubs;
+    std::shared_ptr<const tc::infer::tensor_converter> _tensor_converter;
     std::chrono::milliseconds _rpc_timeout;
+    std::unique_ptr<tc::infer::model_metadata_cache> _metadata_cache;
+    std::unique_ptr<tc::infer::client_statistics_recorder> _statistics;
 };
 
 }
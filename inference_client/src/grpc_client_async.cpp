@@ -1,217 +1,234 @@
-#include "grpc_client.hpp"
-#include <grpcpp/channel.h>
-#include <grpcpp/create_channel.h>
-#include <grpcpp/client_context.h>
-#include <grpcpp/support/status.h>
+#include "grpc_client_async.hpp"
+#include "protobuf_arena.hpp"
+
+#include <algorithm>
 
 namespace tc::infer
 {
-grpc_client::grpc_client(const std::string& channel_address)
-    : _stub{ inference::GRPCInferenceService::NewStub(grpc::CreateChannel(channel_address, grpc::InsecureChannelCredentials())) }
-    , _tensor_converter{ std::make_unique<tc::infer::tensor_converter>() }
+grpc_client_async::grpc_client_async(std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub, const tc::infer::client_options& options)
+    : grpc_client(std::move(stub), options)
+{
+    start_rpc_handlers(options.completion_queue_threads);
+}
+
+grpc_client_async::grpc_client_async(std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs, const tc::infer::client_options& options)
+    : grpc_client(std::move(stubs), options)
 {
-    // _async_completion_queue = std::make_unique<grpc::CompletionQueue>();
-    // for (auto thread_idx = 0; thread_idx < num_async_threads; ++thread_idx)
-    //     _async_grpc_threads.emplace_back(std::thread([this](const std::shared_ptr<grpc::CompletionQueue>& cq) { rpc_handler(cq); }, _async_completion_queue));
+    start_rpc_handlers(options.completion_queue_threads);
 }
 
-grpc_client::~grpc_client()
+grpc_client_async::grpc_client_async(const std::vector<std::shared_ptr<grpc::ChannelInterface>>& channels, const tc::infer::client_options& options)
+    : grpc_client(channels, options)
 {
-    // _async_completion_queue->Shutdown();
-    // for (auto&& t : _async_grpc_threads)
-    //     if (t.joinable()) t.join();
+    start_rpc_handlers(options.completion_queue_threads);
 }
 
-void grpc_client::check_status(grpc::Status rpc_status) const
+void grpc_client_async::start_rpc_handlers(unsigned num_threads)
 {
-    switch(rpc_status.error_code())
+    const unsigned num_async_threads = std::max(num_threads, 1u);
+    _async_grpc_threads.reserve(num_async_threads);
+    for (unsigned thread_idx = 0; thread_idx < num_async_threads; ++thread_idx)
     {
-        case grpc::StatusCode::OK:
-            break;
-        case grpc::StatusCode::DEADLINE_EXCEEDED:
-            throw tc::infer::timeout_error(rpc_status.error_message());
-            break;
-        default:
-            throw std::runtime_error(rpc_status.error_message());
-            break;
+        _async_grpc_threads.emplace_back([this] { rpc_handler(); });
     }
 }
 
-bool grpc_client::is_server_live()
+grpc_client_async::~grpc_client_async()
 {
-    inference::ServerLiveRequest request;
-    inference::ServerLiveResponse response;
-    grpc::ClientContext context;
-
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    const grpc::Status rpc_status = _stub->ServerLive(&context, request, &response);
-    check_status(rpc_status);
-
-    return response.live();
+    // Pending calls are still delivered (at the latest when their deadline expires) before Next returns false
+    _async_completion_queue.Shutdown();
+    for (auto&& t : _async_grpc_threads)
+    {
+        if (t.joinable())
+            t.join();
+    }
 }
 
-bool grpc_client::is_server_ready()
+void grpc_client_async::rpc_handler()
 {
-    inference::ServerReadyRequest request;
-    inference::ServerReadyResponse response;
-    grpc::ClientContext context;
-
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    const grpc::Status rpc_status = _stub->ServerReady(&context, request, &response);
-    check_status(rpc_status);
+    void* tag = nullptr;
+    bool ok = false;
 
-    return response.ready();
+    while (_async_completion_queue.Next(&tag, &ok))
+    {
+        auto rpc = static_cast<AsyncClientCall*>(tag);
+        if (!rpc->proceed(ok))
+        {
+            delete rpc;
+        }
+    }
 }
 
-tc::infer::server_metadata grpc_client::server_metadata()
+std::future<tc::infer::infer_response> grpc_client_async::infer_async(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout)
 {
-    inference::ServerMetadataRequest request;
-    inference::ServerMetadataResponse response;
-    grpc::ClientContext context;
-
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    grpc::Status rpc_status = _stub->ServerMetadata(&context, request, &response);
-    check_status(rpc_status);
+    auto promise = std::make_shared<std::promise<tc::infer::infer_response>>();
+    auto future = promise->get_future();
 
-    const std::vector<std::string> server_extensions = { response.extensions().begin(), response.extensions().end() };
-    tc::infer::server_metadata metadata = {response.name(), response.version(), std::move(server_extensions) };
+    infer_async(infer_request, [promise](tc::infer::infer_response response, std::exception_ptr error)
+    {
+        if (error)
+            promise->set_exception(error);
+        else
+            promise->set_value(std::move(response));
+    }, infer_timeout);
 
-    return metadata;
+    return future;
 }
 
-bool grpc_client::is_model_ready(const std::string& model_name, const std::string& model_version)
+void grpc_client_async::infer_async(const tc::infer::infer_request& infer_request, infer_callback callback, std::chrono::milliseconds infer_timeout)
 {
-    inference::ModelReadyRequest request;
-    inference::ModelReadyResponse response;
-    grpc::ClientContext context;
+    const auto start = std::chrono::steady_clock::now();
 
-    request.set_name(model_name);
-    request.set_version(model_version);
+    // The request is serialized when the call is started, so it can live on the thread arena
+    tc::infer::thread_arena_scope arena_scope;
+    const inference::ModelInferRequest* request = nullptr;
+    std::exception_ptr error;
+    try
+    {
+        validate_request(infer_request, false);
+        request = _tensor_converter->get_infer_request(infer_request, arena_scope.arena());
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
 
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    grpc::Status rpc_status = _stub->ModelReady(&context, request, &response);
-    check_status(rpc_status);
+    if (error)
+    {
+        record_client_error(infer_request, start);
+        callback(tc::infer::infer_response{}, error);
+        return;
+    }
 
-    return response.ready();
+    infer_async_call(*request, std::move(callback), infer_timeout);
 }
 
-std::vector<std::string> grpc_client::model_list()
+void grpc_client_async::infer_async_call(const inference::ModelInferRequest& request, infer_callback callback, std::chrono::milliseconds infer_timeout)
 {
-    inference::ModelListRequest request;
-    inference::ModelListResponse response;
-    grpc::ClientContext context;
-
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    grpc::Status rpc_status = _stub->ModelList(&context, request, &response);
-    check_status(rpc_status);
-    
-    const auto models = response.models();
-    const std::vector<std::string> model_list(models.begin(), models.end());
-    
-    return model_list;
+    // The request only lives until the call is started: its model and size are kept for the statistics
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t bytes_sent = request.ByteSizeLong();
+
+    async_unary_call<inference::ModelInferResponse>(
+        &inference::GRPCInferenceService::StubInterface::PrepareAsyncModelInfer,
+        request,
+        infer_timeout,
+        [this, callback = std::move(callback), model_name = request.model_name(), model_version = request.model_version(), start, bytes_sent](std::shared_ptr<inference::ModelInferResponse> response, const grpc::Status& rpc_status)
+        {
+            const auto rpc_latency = std::chrono::steady_clock::now() - start;
+
+            tc::infer::infer_response infer_response;
+            std::exception_ptr error;
+            try
+            {
+                check_status(rpc_status);
+                infer_response = _tensor_converter->get_infer_response(response);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            const int status_code = rpc_status.ok() && error ? tc::infer::client_statistics_recorder::client_error : rpc_status.error_code();
+            const uint64_t bytes_received = rpc_status.ok() ? response->ByteSizeLong() : 0;
+            _statistics->record(model_name, model_version, { std::chrono::steady_clock::now() - start, rpc_latency, status_code, bytes_sent, bytes_received });
+
+            callback(std::move(infer_response), error);
+        });
 }
 
-bool grpc_client::model_load(const std::string& model_name, const std::string&)
+tc::infer::awaitable<tc::infer::infer_response> grpc_client_async::infer_co(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout)
 {
-    inference::ModelLoadRequest request;
-    inference::ModelLoadResponse response;
-    grpc::ClientContext context;
+    const auto start = std::chrono::steady_clock::now();
 
-    request.set_name(model_name);
+    // The request is converted eagerly, so infer_request (and any borrowed tensor) is not referenced after this call returns
+    std::shared_ptr<const inference::ModelInferRequest> request;
+    std::exception_ptr error;
+    try
+    {
+        validate_request(infer_request, false);
+        request = std::make_shared<const inference::ModelInferRequest>(_tensor_converter->get_infer_request(infer_request));
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
 
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    grpc::Status rpc_status = _stub->ModelLoad(&context, request, &response);
-    check_status(rpc_status);
+    if (error)
+    {
+        record_client_error(infer_request, start);
+        return tc::infer::awaitable<tc::infer::infer_response>([error](infer_callback callback)
+        {
+            callback(tc::infer::infer_response{}, error);
+        });
+    }
 
-    return true;
+    return tc::infer::awaitable<tc::infer::infer_response>([this, request, infer_timeout](infer_callback callback)
+    {
+        infer_async_call(*request, std::move(callback), infer_timeout);
+    });
 }
 
-bool grpc_client::model_unload(const std::string& model_name, const std::string&)
+tc::infer::awaitable<bool> grpc_client_async::is_model_ready_co(const std::string& model_name, const std::string& model_version)
 {
-    inference::ModelUnloadRequest request;
-    inference::ModelUnloadResponse response;
-    grpc::ClientContext context;
-
+    inference::ModelReadyRequest request;
     request.set_name(model_name);
+    request.set_version(model_version);
 
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    grpc::Status rpc_status = _stub->ModelUnload(&context, request, &response);
-    check_status(rpc_status);
-
-    return true;
+    return tc::infer::awaitable<bool>([this, request = std::move(request)](tc::infer::awaitable<bool>::result_callback callback)
+    {
+        async_unary_call<inference::ModelReadyResponse>(
+            &inference::GRPCInferenceService::StubInterface::PrepareAsyncModelReady,
+            request,
+            _rpc_timeout,
+            [this, callback = std::move(callback)](std::shared_ptr<inference::ModelReadyResponse> response, const grpc::Status& rpc_status)
+            {
+                std::exception_ptr error;
+                try
+                {
+                    check_status(rpc_status);
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+
+                callback(!error && response->ready(), error);
+            });
+    });
 }
 
-tc::infer::model_metadata grpc_client::model_metadata(const std::string& model_name, const std::string& model_version)
+tc::infer::awaitable<tc::infer::model_metadata> grpc_client_async::model_metadata_co(const std::string& model_name, const std::string& model_version)
 {
     inference::ModelMetadataRequest request;
-    inference::ModelMetadataResponse response;
-    grpc::ClientContext context;
-
     request.set_name(model_name);
     request.set_version(model_version);
 
-    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
-    grpc::Status rpc_status = _stub->ModelMetadata(&context, request, &response);
-    check_status(rpc_status);
-
-    tc::infer::model_metadata metadata;
-    metadata.model_name = response.name();
-    metadata.model_versions = std::vector<std::string>{ response.versions().begin(), response.versions().end() };
-    metadata.platform = response.platform();
-    
-    for(auto&& input : response.inputs())
-    {
-        std::vector<int64_t> shape { input.shape().begin(), input.shape().end() };
-        metadata.inputs.push_back({input.name(), input.datatype(), shape});
-    }
-
-    for(auto&& output : response.outputs())
-    {
-        std::vector<int64_t> shape { output.shape().begin(), output.shape().end() };
-        metadata.outputs.push_back({output.name(), output.datatype(), shape});
-    }
-    
-    return metadata;
-}
-
-tc::infer::infer_response grpc_client::infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds timeout)
-{
-    inference::ModelInferResponse response;
-    grpc::ClientContext context;
-
-    std::map<std::string, std::string> metadata {};
-    for (auto&& [key, value] : metadata)
+    return tc::infer::awaitable<tc::infer::model_metadata>([this, request = std::move(request), model_name, model_version](tc::infer::awaitable<tc::infer::model_metadata>::result_callback callback)
     {
-        context.AddMetadata(key, value);
-    }
-    
-    auto request = _tensor_converter->get_infer_request(infer_request);
-
-    context.set_deadline(std::chrono::system_clock::now() + timeout);
-    grpc::Status rpc_status = _stub->ModelInfer(&context, request, &response);
-    check_status(rpc_status);
-
-    auto infer_response = _tensor_converter->get_infer_response(response);
-    return infer_response;
-}
-
-void grpc_client::rpc_handler(const std::shared_ptr<grpc::CompletionQueue>& cq)
-{
-    (void)cq;
-    // void* tag;
-    // bool ok = false;
-    
-    // while (cq->Next(&tag, &ok))
-    // {
-    //     if (!ok)
-    //     {
-    //         // SPDLOG_WARN("Client stream closed");
-    //         break;
-    //     }
-
-    //     auto rpc = static_cast<AsyncClientCall*>(tag);
-    //     rpc->proceed(ok);
-    // }
+        async_unary_call<inference::ModelMetadataResponse>(
+            &inference::GRPCInferenceService::StubInterface::PrepareAsyncModelMetadata,
+            request,
+            _rpc_timeout,
+            [this, callback = std::move(callback), model_name, model_version](std::shared_ptr<inference::ModelMetadataResponse> response, const grpc::Status& rpc_status)
+            {
+                tc::infer::model_metadata metadata;
+                std::exception_ptr error;
+                try
+                {
+                    check_status(rpc_status);
+                    metadata = get_model_metadata(*response);
+                    if (_metadata_cache)
+                        _metadata_cache->insert(model_name, model_version, std::make_shared<const tc::infer::model_metadata>(metadata));
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+
+                callback(std::move(metadata), error);
+            });
+    });
 }
 
 }
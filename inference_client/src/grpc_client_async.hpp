@@ -1,41 +1,57 @@
 #pragma once
 
+#include <teiacare/inference_client/async_client_interface.hpp>
+#include "client_rpc_unary_async.hpp"
 #include "grpc_client.hpp"
 
+#include <grpcpp/completion_queue.h>
+
 #include <vector>
 #include <memory>
 #include <string>
 #include <chrono>
+#include <thread>
 
 namespace tc::infer
 {
-class grpc_client_async final : public grpc_client
+class grpc_client_async final : public grpc_client, public async_client_interface
 {
 public:
-    explicit grpc_client_async(const std::string& channel_address);
+    explicit grpc_client_async(std::unique_ptr<inference::GRPCInferenceService::StubInterface> stub, const tc::infer::client_options& options);
+    explicit grpc_client_async(std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs, const tc::infer::client_options& options);
+    explicit grpc_client_async(const std::vector<std::shared_ptr<grpc::ChannelInterface>>& channels, const tc::infer::client_options& options);
     ~grpc_client_async();
 
-    bool is_server_live() override;
-    bool is_server_ready() override;
-    tc::infer::server_metadata server_metadata() override;
-    std::vector<std::string> model_list() override;
-    bool is_model_ready(const std::string& model_name, const std::string& model_version) override;
-    bool model_load(const std::string& model_name, const std::string& model_version) override;
-    bool model_unload(const std::string& model_name, const std::string& model_version) override;
-    tc::infer::model_metadata model_metadata(const std::string& model_name, const std::string& model_version) override;
-    tc::infer::infer_response infer(const tc::infer::infer_request& infer_request, std::chrono::milliseconds timeout) override;
+    std::future<tc::infer::infer_response> infer_async(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout) override;
+    void infer_async(const tc::infer::infer_request& infer_request, infer_callback callback, std::chrono::milliseconds infer_timeout) override;
+
+    tc::infer::awaitable<tc::infer::infer_response> infer_co(const tc::infer::infer_request& infer_request, std::chrono::milliseconds infer_timeout) override;
+    tc::infer::awaitable<bool> is_model_ready_co(const std::string& model_name, const std::string& model_version) override;
+    tc::infer::awaitable<tc::infer::model_metadata> model_metadata_co(const std::string& model_name, const std::string& model_version) override;
 
 protected:
-    void rpc_handler(const std::shared_ptr<grpc::CompletionQueue>& cq);
-    void check_status(grpc::Status rpc_status) const;
+    void start_rpc_handlers(unsigned num_threads);
+    void rpc_handler();
+    void infer_async_call(const inference::ModelInferRequest& request, infer_callback callback, std::chrono::milliseconds infer_timeout);
+
+    template<typename ResponseT, typename RequestT, typename PrepareAsyncT>
+    void async_unary_call(PrepareAsyncT prepare_async, const RequestT& request, std::chrono::milliseconds timeout, typename AsyncClientCallback<ResponseT>::response_callback on_response)
+    {
+        auto call = std::make_unique<AsyncClientUnaryCall<ResponseT>>();
+        call->context.set_deadline(std::chrono::system_clock::now() + timeout);
+        call->set_response_callback(std::move(on_response));
+        call->stub = _stubs.acquire();
+        call->rpc = std::invoke(prepare_async, call->stub.get(), &call->context, request, &_async_completion_queue);
+        call->rpc->StartCall();
+
+        // Ownership of the call is transferred to the completion queue, the tag is released by rpc_handler
+        AsyncClientUnaryCall<ResponseT>* tag = call.release();
+        tag->rpc->Finish(tag->response.get(), &tag->result_code, tag);
+    }
 
 private:
-    std::unique_ptr<inference::GRPCInferenceService::Stub> _stub;
-    std::unique_ptr<tc::infer::tensor_converter> _tensor_converter;
-    
-    // std::shared_ptr<grpc::CompletionQueue> _async_completion_queue;
-    // std::vector<std::thread> _async_grpc_threads;
-    // unsigned num_async_threads = 1u;
+    grpc::CompletionQueue _async_completion_queue;
+    std::vector<std::thread> _async_grpc_threads;
 };
 
 }
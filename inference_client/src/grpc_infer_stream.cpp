@@ -0,0 +1,146 @@
+#include "grpc_infer_stream.hpp"
+#include "grpc_client.hpp"
+#include "protobuf_arena.hpp"
+
+#include <stdexcept>
+
+namespace tc::infer
+{
+grpc_infer_stream::grpc_infer_stream(std::shared_ptr<tc::infer::stub_pool::stub_type> stub, std::shared_ptr<const tc::infer::tensor_converter> tensor_converter, std::chrono::milliseconds close_timeout)
+    : _stub{ std::move(stub) }
+    , _tensor_converter{ std::move(tensor_converter) }
+    , _close_timeout{ close_timeout }
+    , _stream{ _stub->ModelStreamInfer(&_context) }
+{
+    _reader_thread = std::thread([this] { read_handler(); });
+}
+
+grpc_infer_stream::~grpc_infer_stream()
+{
+    // Half-close the stream: the server completes the requests in flight and then ends the stream, unless it does not
+    // within the close timeout. The cancellation unblocks the reads and writes, failing the requests still in flight
+    const auto deadline = std::chrono::steady_clock::now() + _close_timeout;
+    {
+        std::unique_lock lock(_write_mutex, std::defer_lock);
+        if (lock.try_lock_until(deadline) && !_writes_done)
+        {
+            _writes_done = true;
+            _stream->WritesDone();
+        }
+    }
+
+    if (_reader_done.get_future().wait_until(deadline) != std::future_status::ready)
+        _context.TryCancel();
+
+    if (_reader_thread.joinable())
+        _reader_thread.join();
+}
+
+std::future<tc::infer::infer_response> grpc_infer_stream::infer(const tc::infer::infer_request& infer_request)
+{
+    tc::infer::thread_arena_scope arena_scope;
+    inference::ModelInferRequest& request = *_tensor_converter->get_infer_request(infer_request, arena_scope.arena());
+    if (request.id().empty())
+    {
+        request.set_id("tc_stream_" + std::to_string(_next_request_id++));
+    }
+
+    std::future<tc::infer::infer_response> future;
+    {
+        std::lock_guard lock(_pending_mutex);
+        if (_stream_error)
+            std::rethrow_exception(_stream_error);
+
+        auto [pending, inserted] = _pending_requests.try_emplace(request.id());
+        if (!inserted)
+            throw std::runtime_error("Request id '" + request.id() + "' is already in flight on this stream");
+
+        future = pending->second.get_future();
+    }
+
+    std::lock_guard lock(_write_mutex);
+    if (_writes_done || !_stream->Write(request))
+    {
+        std::lock_guard pending_lock(_pending_mutex);
+        if (auto pending = _pending_requests.find(request.id()); pending != _pending_requests.end())
+        {
+            pending->second.set_exception(std::make_exception_ptr(std::runtime_error("Unable to write the request on the inference stream")));
+            _pending_requests.erase(pending);
+        }
+    }
+
+    return future;
+}
+
+void grpc_infer_stream::read_handler()
+{
+    while (true)
+    {
+        auto stream_response = tc::infer::make_arena_message<inference::ModelStreamInferResponse>();
+        if (!_stream->Read(stream_response.get()))
+            break;
+
+        const std::string& id = stream_response->infer_response().id();
+
+        tc::infer::infer_response infer_response;
+        std::exception_ptr error;
+        try
+        {
+            if (!stream_response->error_message().empty())
+                throw std::runtime_error(stream_response->error_message());
+
+            // Output tensors alias the stream response, which is kept alive by the returned tensors
+            std::shared_ptr<const inference::ModelInferResponse> response(stream_response, &stream_response->infer_response());
+            infer_response = _tensor_converter->get_infer_response(response);
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock(_pending_mutex);
+        auto pending = _pending_requests.find(id);
+        if (pending == _pending_requests.end())
+            continue;
+
+        if (error)
+            pending->second.set_exception(error);
+        else
+            pending->second.set_value(std::move(infer_response));
+
+        _pending_requests.erase(pending);
+    }
+
+    // Finish must not run concurrently with Write, and no write is allowed after it
+    std::unique_lock write_lock(_write_mutex);
+    _writes_done = true;
+    const grpc::Status rpc_status = _stream->Finish();
+    write_lock.unlock();
+
+    std::exception_ptr error;
+    try
+    {
+        tc::infer::grpc_client::check_status(rpc_status);
+        throw std::runtime_error("Inference stream closed by the server");
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+    }
+
+    fail_pending_requests(error);
+    _reader_done.set_value();
+}
+
+void grpc_infer_stream::fail_pending_requests(std::exception_ptr error)
+{
+    std::lock_guard lock(_pending_mutex);
+    _stream_error = error;
+    for (auto&& [id, pending] : _pending_requests)
+    {
+        pending.set_exception(error);
+    }
+    _pending_requests.clear();
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <teiacare/inference_client/infer_stream_interface.hpp>
+#include <services.grpc.pb.h>
+#include "stub_pool.hpp"
+#include "tensor_converter.hpp"
+
+#include <grpcpp/client_context.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace tc::infer
+{
+// The stream shares the stub (and its channel) and the tensor converter of the client that created it, so it can outlive the client.
+// When destroyed, the server has close_timeout to complete the requests in flight before the stream is cancelled
+class grpc_infer_stream final : public infer_stream_interface
+{
+public:
+    explicit grpc_infer_stream(std::shared_ptr<tc::infer::stub_pool::stub_type> stub, std::shared_ptr<const tc::infer::tensor_converter> tensor_converter, std::chrono::milliseconds close_timeout);
+    ~grpc_infer_stream();
+
+    std::future<tc::infer::infer_response> infer(const tc::infer::infer_request& infer_request) override;
+
+protected:
+    void read_handler();
+    void fail_pending_requests(std::exception_ptr error);
+
+private:
+    std::shared_ptr<tc::infer::stub_pool::stub_type> _stub;
+    std::shared_ptr<const tc::infer::tensor_converter> _tensor_converter;
+    const std::chrono::milliseconds _close_timeout;
+    grpc::ClientContext _context;
+    std::unique_ptr<grpc::ClientReaderWriterInterface<inference::ModelInferRequest, inference::ModelStreamInferResponse>> _stream;
+
+    // Timed, so that a write blocked by a stalled server does not block the destructor
+    std::timed_mutex _write_mutex;
+    bool _writes_done = false;
+
+    std::mutex _pending_mutex;
+    std::unordered_map<std::string, std::promise<tc::infer::infer_response>> _pending_requests;
+    std::exception_ptr _stream_error;
+
+    std::atomic<uint64_t> _next_request_id = 0;
+    std::promise<void> _reader_done;
+    std::thread _reader_thread;
+};
+
+}
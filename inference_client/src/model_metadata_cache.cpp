@@ -0,0 +1,94 @@
+#include "model_metadata_cache.hpp"
+#include <teiacare/inference_client/invalid_request_error.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace tc::infer
+{
+namespace
+{
+std::string shape_str(std::span<const int64_t> shape)
+{
+    std::string str = "[";
+    for (size_t i = 0; i < shape.size(); ++i)
+    {
+        if (i != 0)
+            str += ',';
+
+        str += std::to_string(shape[i]);
+    }
+    str += ']';
+    return str;
+}
+
+void validate_input(const tc::infer::model_metadata& metadata, const std::string& name, tc::infer::data_type datatype, std::span<const int64_t> shape)
+{
+    const auto input = std::find_if(metadata.inputs.begin(), metadata.inputs.end(), [&name](auto&& tensor) { return tensor.name == name; });
+    if (input == metadata.inputs.end())
+        throw tc::infer::invalid_request_error("Unknown input '" + name + "' for model '" + metadata.model_name + "'");
+
+    if (input->datatype != datatype.name())
+        throw tc::infer::invalid_request_error("Input '" + name + "' of model '" + metadata.model_name + "' expects data type " + input->datatype + ", got " + datatype.str());
+
+    // A -1 dimension is dynamic and matches any size
+    const bool shape_matches = input->shape.size() == shape.size() && std::equal(shape.begin(), shape.end(), input->shape.begin(), [](int64_t dim, int64_t expected) { return expected == -1 || dim == expected; });
+    if (!shape_matches)
+        throw tc::infer::invalid_request_error("Input '" + name + "' of model '" + metadata.model_name + "' expects shape " + shape_str(input->shape) + ", got " + shape_str(shape));
+}
+
+}
+
+model_metadata_cache::model_metadata_cache(std::chrono::milliseconds ttl)
+    : _ttl{ ttl }
+{
+}
+
+std::string model_metadata_cache::key(const std::string& model_name, const std::string& model_version)
+{
+    std::string key;
+    key.reserve(model_name.size() + model_version.size() + 1);
+    key.append(model_name).push_back('\0');
+    key.append(model_version);
+    return key;
+}
+
+std::shared_ptr<const tc::infer::model_metadata> model_metadata_cache::find(const std::string& model_name, const std::string& model_version) const
+{
+    std::shared_lock lock(_mutex);
+    const auto cached = _entries.find(key(model_name, model_version));
+    if (cached == _entries.end() || clock::now() >= cached->second.expiration)
+        return nullptr;
+
+    return cached->second.metadata;
+}
+
+void model_metadata_cache::insert(const std::string& model_name, const std::string& model_version, std::shared_ptr<const tc::infer::model_metadata> metadata)
+{
+    std::unique_lock lock(_mutex);
+    _entries.insert_or_assign(key(model_name, model_version), entry{ model_name, std::move(metadata), clock::now() + _ttl });
+}
+
+void model_metadata_cache::invalidate(const std::string& model_name)
+{
+    std::unique_lock lock(_mutex);
+    std::erase_if(_entries, [&model_name](auto&& cached) { return cached.second.model_name == model_name; });
+}
+
+void model_metadata_cache::validate(const tc::infer::model_metadata& metadata, const tc::infer::infer_request& infer_request)
+{
+    for (const tc::infer::infer_tensor& input : infer_request.input_tensors)
+    {
+        validate_input(metadata, input.name(), input.datatype(), input.shape());
+    }
+}
+
+void model_metadata_cache::validate(const tc::infer::model_metadata& metadata, const tc::infer::prepared_request& prepared_request)
+{
+    for (const tc::infer::tensor_spec& input : prepared_request.inputs())
+    {
+        validate_input(metadata, input.name, input.datatype, input.shape);
+    }
+}
+
+}
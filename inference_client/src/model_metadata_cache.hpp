@@ -0,0 +1,50 @@
+#pragma once
+
+#include <teiacare/inference_client/infer_request.hpp>
+#include <teiacare/inference_client/model_metadata.hpp>
+#include <teiacare/inference_client/prepared_request.hpp>
+
+#include <chrono>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace tc::infer
+{
+// Thread safe cache of the model metadata, entries expire after the configured time to live
+class model_metadata_cache
+{
+public:
+    explicit model_metadata_cache(std::chrono::milliseconds ttl);
+
+    [[nodiscard]]
+    std::shared_ptr<const tc::infer::model_metadata> find(const std::string& model_name, const std::string& model_version) const;
+
+    void insert(const std::string& model_name, const std::string& model_version, std::shared_ptr<const tc::infer::model_metadata> metadata);
+
+    // Removes every cached version of the model
+    void invalidate(const std::string& model_name);
+
+    // Check the input names, data types, ranks and the non dynamic dimensions, throwing invalid_request_error on the first mismatch
+    static void validate(const tc::infer::model_metadata& metadata, const tc::infer::infer_request& infer_request);
+    static void validate(const tc::infer::model_metadata& metadata, const tc::infer::prepared_request& prepared_request);
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct entry
+    {
+        std::string model_name;
+        std::shared_ptr<const tc::infer::model_metadata> metadata;
+        clock::time_point expiration;
+    };
+
+    static std::string key(const std::string& model_name, const std::string& model_version);
+
+    const std::chrono::milliseconds _ttl;
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<std::string, entry> _entries;
+};
+
+}
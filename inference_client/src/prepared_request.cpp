@@ -0,0 +1,108 @@
+#include <teiacare/inference_client/prepared_request.hpp>
+#include <teiacare/inference_client/invalid_request_error.hpp>
+#include "prepared_request_skeleton.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace tc::infer
+{
+prepared_request::prepared_request(const std::string& model_name, const std::string& model_version, std::vector<tensor_spec> inputs, std::vector<std::string> requested_outputs)
+{
+    auto skeleton = std::make_shared<prepared_request_skeleton>();
+    skeleton->model_name = model_name;
+    skeleton->model_version = model_version;
+
+    inference::ModelInferRequest& request = skeleton->request;
+    request.set_model_name(model_name);
+    request.set_model_version(model_version);
+
+    for (const tensor_spec& input : inputs)
+    {
+        if (input.datatype == data_type::Unknown)
+            throw std::runtime_error("Unknown data type for input '" + input.name + "' of the prepared request");
+
+        if (std::any_of(input.shape.begin(), input.shape.end(), [](int64_t dim) { return dim < 0; }))
+            throw std::runtime_error("Dynamic shape for input '" + input.name + "' of the prepared request");
+
+        inference::ModelInferRequest_InferInputTensor* tensor = request.add_inputs();
+        tensor->set_name(input.name);
+        tensor->set_datatype(input.datatype.name().data(), input.datatype.name().size());
+        for (int64_t dim : input.shape)
+        {
+            tensor->add_shape(dim);
+        }
+
+        const size_t element_count = std::accumulate(input.shape.begin(), input.shape.end(), size_t{1}, std::multiplies<>());
+        skeleton->input_element_counts.push_back(element_count);
+        skeleton->input_byte_sizes.push_back(element_count * input.datatype.element_size());
+        skeleton->has_string_inputs |= input.datatype == data_type::String;
+        skeleton->has_raw_only_inputs |= input.datatype == data_type::Fp16 || input.datatype == data_type::Bf16;
+    }
+
+    // BYTES inputs are only sent as typed contents and FP16/BF16 inputs as raw contents, which cannot be mixed in a request
+    if (skeleton->has_string_inputs && skeleton->has_raw_only_inputs)
+        throw tc::infer::invalid_request_error("BYTES and FP16/BF16 inputs cannot be sent in the same request of model '" + model_name + "'");
+
+    for (const std::string& output : requested_outputs)
+    {
+        request.add_outputs()->set_name(output);
+    }
+
+    request.SerializeToString(&skeleton->header);
+    skeleton->inputs = std::move(inputs);
+
+    _bound_inputs.resize(skeleton->inputs.size());
+    _skeleton = std::move(skeleton);
+}
+
+const std::string& prepared_request::model_name() const noexcept
+{
+    return _skeleton->model_name;
+}
+
+const std::string& prepared_request::model_version() const noexcept
+{
+    return _skeleton->model_version;
+}
+
+const std::vector<tensor_spec>& prepared_request::inputs() const noexcept
+{
+    return _skeleton->inputs;
+}
+
+size_t prepared_request::input_index(const std::string& name) const
+{
+    const auto& inputs = _skeleton->inputs;
+    const auto input = std::find_if(inputs.begin(), inputs.end(), [&name](const tensor_spec& spec) { return spec.name == name; });
+    if (input == inputs.end())
+        throw std::runtime_error("Unknown input '" + name + "' of the prepared request");
+
+    return static_cast<size_t>(std::distance(inputs.begin(), input));
+}
+
+void prepared_request::set_input(size_t index, std::span<const std::byte> data)
+{
+    std::shared_ptr<const std::byte> borrowed_data(std::shared_ptr<const std::byte>{}, data.data());
+    bind(index, std::move(borrowed_data), data.size());
+}
+
+void prepared_request::set_input(size_t index, const tc::infer::infer_tensor& tensor)
+{
+    if (tensor.shared_memory())
+        throw std::runtime_error("Shared memory tensors cannot be bound to a prepared request");
+
+    bind(index, tensor.shared_data(), tensor.byte_size());
+}
+
+void prepared_request::bind(size_t index, std::shared_ptr<const std::byte> data, size_t byte_size)
+{
+    const size_t expected_byte_size = _skeleton->input_byte_sizes.at(index);
+    if (expected_byte_size != 0 && byte_size != expected_byte_size)
+        throw std::runtime_error("Input '" + _skeleton->inputs[index].name + "' of the prepared request expects " + std::to_string(expected_byte_size) + " bytes, got " + std::to_string(byte_size));
+
+    _bound_inputs[index] = { std::move(data), byte_size };
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <teiacare/inference_client/prepared_request.hpp>
+#include <services.grpc.pb.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace tc::infer
+{
+// Immutable part of a prepared request, shared by all its copies
+struct prepared_request_skeleton
+{
+    std::string model_name;
+    std::string model_version;
+    std::vector<tensor_spec> inputs;
+
+    // Expected byte size of each input, 0 for BYTES inputs whose size depends on their contents
+    std::vector<size_t> input_byte_sizes;
+    std::vector<size_t> input_element_counts;
+    bool has_string_inputs = false;
+
+    // FP16 and BF16 inputs, which have no typed contents field
+    bool has_raw_only_inputs = false;
+
+    // Request without id and tensor contents, and its wire encoding
+    inference::ModelInferRequest request;
+    std::string header;
+};
+
+}
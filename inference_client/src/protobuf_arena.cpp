@@ -0,0 +1,65 @@
+#include "protobuf_arena.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace tc::infer
+{
+namespace
+{
+constexpr size_t thread_arena_initial_block_size = 64 * 1024;
+
+struct thread_arena
+{
+    thread_arena()
+        : initial_block(thread_arena_initial_block_size)
+        , arena{ [this]
+        {
+            google::protobuf::ArenaOptions options;
+            options.initial_block = initial_block.data();
+            options.initial_block_size = initial_block.size();
+            return options;
+        }() }
+    {
+    }
+
+    std::vector<char> initial_block;
+    google::protobuf::Arena arena;
+    int scopes = 0;
+};
+
+thread_arena& get_thread_arena()
+{
+    thread_local thread_arena arena;
+    return arena;
+}
+
+}
+
+thread_arena_scope::thread_arena_scope()
+{
+    ++get_thread_arena().scopes;
+}
+
+thread_arena_scope::~thread_arena_scope()
+{
+    thread_arena& arena = get_thread_arena();
+    if (--arena.scopes == 0)
+        arena.arena.Reset();
+}
+
+google::protobuf::Arena* thread_arena_scope::arena() const noexcept
+{
+    return &get_thread_arena().arena;
+}
+
+google::protobuf::ArenaOptions message_arena_options()
+{
+    // Responses hold a handful of small messages next to the (large) output contents
+    google::protobuf::ArenaOptions options;
+    options.start_block_size = 1024;
+    options.max_block_size = 64 * 1024;
+    return options;
+}
+
+}
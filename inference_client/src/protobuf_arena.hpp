@@ -0,0 +1,40 @@
+#pragma once
+
+#include <google/protobuf/arena.h>
+
+#include <memory>
+
+namespace tc::infer
+{
+// Arena shared by the messages built on the calling thread. The arena is reset when the outermost scope on the thread is
+// destroyed, freeing every block but the 64 KiB initial block, so messages allocated here must not outlive the scope.
+class thread_arena_scope
+{
+public:
+    thread_arena_scope();
+    ~thread_arena_scope();
+
+    thread_arena_scope(const thread_arena_scope&) = delete;
+    thread_arena_scope& operator=(const thread_arena_scope&) = delete;
+
+    [[nodiscard]]
+    google::protobuf::Arena* arena() const noexcept;
+};
+
+google::protobuf::ArenaOptions message_arena_options();
+
+// Message allocated on its own arena: the returned pointer (and any pointer aliasing it) owns the whole arena
+template<typename MessageT>
+std::shared_ptr<MessageT> make_arena_message()
+{
+    struct arena_message
+    {
+        google::protobuf::Arena arena { message_arena_options() };
+        MessageT* message = google::protobuf::Arena::CreateMessage<MessageT>(&arena);
+    };
+
+    auto holder = std::make_shared<arena_message>();
+    return std::shared_ptr<MessageT>(holder, holder->message);
+}
+
+}
@@ -0,0 +1,77 @@
+#include <teiacare/inference_client/shared_memory.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace tc::infer
+{
+system_shared_memory_region::system_shared_memory_region(const std::string& key, size_t byte_size)
+    : _key{ key }
+    , _byte_size{ byte_size }
+{
+    const int fd = ::shm_open(_key.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+        throw std::runtime_error("Unable to create shared memory object '" + _key + "': " + std::strerror(errno));
+
+    if (::ftruncate(fd, static_cast<off_t>(_byte_size)) == -1)
+    {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(_key.c_str());
+        throw std::runtime_error("Unable to resize shared memory object '" + _key + "': " + std::strerror(error));
+    }
+
+    void* data = ::mmap(nullptr, _byte_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        ::shm_unlink(_key.c_str());
+        throw std::runtime_error("Unable to map shared memory object '" + _key + "': " + std::strerror(error));
+    }
+
+    _data = static_cast<std::byte*>(data);
+}
+
+system_shared_memory_region::~system_shared_memory_region()
+{
+    release();
+}
+
+system_shared_memory_region::system_shared_memory_region(system_shared_memory_region&& other) noexcept
+    : _key{ std::move(other._key) }
+    , _byte_size{ std::exchange(other._byte_size, 0) }
+    , _data{ std::exchange(other._data, nullptr) }
+{
+}
+
+auto system_shared_memory_region::operator=(system_shared_memory_region&& other) noexcept -> system_shared_memory_region&
+{
+    if (this != &other)
+    {
+        release();
+        _key = std::move(other._key);
+        _byte_size = std::exchange(other._byte_size, 0);
+        _data = std::exchange(other._data, nullptr);
+    }
+    return *this;
+}
+
+void system_shared_memory_region::release() noexcept
+{
+    if (!_data)
+        return;
+
+    ::munmap(_data, _byte_size);
+    ::shm_unlink(_key.c_str());
+    _data = nullptr;
+}
+
+}
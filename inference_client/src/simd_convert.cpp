@@ -0,0 +1,234 @@
+#include "simd_convert.hpp"
+#include "cpu_features.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TC_INFER_SIMD_SSE2
+#endif
+
+#if defined(TC_INFER_SIMD_SSE2) && defined(TC_INFER_X86_DISPATCH)
+#define TC_INFER_SIMD_AVX2_DISPATCH
+#endif
+
+namespace tc::infer::simd
+{
+namespace
+{
+#if defined(TC_INFER_SIMD_SSE2)
+// Sign-extends the low 16 (or 8) bits of each lane, so that the saturating packs below never saturate
+inline __m128i low_16_bits(__m128i values) noexcept
+{
+    return _mm_srai_epi32(_mm_slli_epi32(values, 16), 16);
+}
+
+inline __m128i low_8_bits(__m128i values) noexcept
+{
+    return _mm_srai_epi32(_mm_slli_epi32(values, 24), 24);
+}
+
+inline __m128i load(const void* source) noexcept
+{
+    return _mm_loadu_si128(static_cast<const __m128i*>(source));
+}
+
+inline void store(void* destination, __m128i values) noexcept
+{
+    _mm_storeu_si128(static_cast<__m128i*>(destination), values);
+}
+
+// The SSE2 widening kernels return the number of converted elements, the remaining ones are left to the scalar loop
+size_t widen_sse2(const int8_t* source, size_t size, int32_t* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i values = load(source + i);
+        const __m128i low = _mm_srai_epi16(_mm_unpacklo_epi8(values, values), 8);
+        const __m128i high = _mm_srai_epi16(_mm_unpackhi_epi8(values, values), 8);
+        store(destination + i, _mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16));
+        store(destination + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16));
+        store(destination + i + 8, _mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16));
+        store(destination + i + 12, _mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16));
+    }
+    return i;
+}
+
+size_t widen_sse2(const uint8_t* source, size_t size, uint32_t* destination) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i values = load(source + i);
+        const __m128i low = _mm_unpacklo_epi8(values, zero);
+        const __m128i high = _mm_unpackhi_epi8(values, zero);
+        store(destination + i, _mm_unpacklo_epi16(low, zero));
+        store(destination + i + 4, _mm_unpackhi_epi16(low, zero));
+        store(destination + i + 8, _mm_unpacklo_epi16(high, zero));
+        store(destination + i + 12, _mm_unpackhi_epi16(high, zero));
+    }
+    return i;
+}
+
+size_t widen_sse2(const int16_t* source, size_t size, int32_t* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i values = load(source + i);
+        store(destination + i, _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+        store(destination + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16));
+    }
+    return i;
+}
+
+size_t widen_sse2(const uint16_t* source, size_t size, uint32_t* destination) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i values = load(source + i);
+        store(destination + i, _mm_unpacklo_epi16(values, zero));
+        store(destination + i + 4, _mm_unpackhi_epi16(values, zero));
+    }
+    return i;
+}
+#endif
+
+#if defined(TC_INFER_SIMD_AVX2_DISPATCH)
+TC_INFER_TARGET("avx2") inline void store_avx2(void* destination, __m256i values) noexcept
+{
+    _mm256_storeu_si256(static_cast<__m256i*>(destination), values);
+}
+
+TC_INFER_TARGET("avx2") size_t widen_avx2(const int8_t* source, size_t size, int32_t* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i values = load(source + i);
+        store_avx2(destination + i, _mm256_cvtepi8_epi32(values));
+        store_avx2(destination + i + 8, _mm256_cvtepi8_epi32(_mm_srli_si128(values, 8)));
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx2") size_t widen_avx2(const uint8_t* source, size_t size, uint32_t* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i values = load(source + i);
+        store_avx2(destination + i, _mm256_cvtepu8_epi32(values));
+        store_avx2(destination + i + 8, _mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)));
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx2") size_t widen_avx2(const int16_t* source, size_t size, int32_t* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        store_avx2(destination + i, _mm256_cvtepi16_epi32(load(source + i)));
+        store_avx2(destination + i + 8, _mm256_cvtepi16_epi32(load(source + i + 8)));
+    }
+    return i;
+}
+
+TC_INFER_TARGET("avx2") size_t widen_avx2(const uint16_t* source, size_t size, uint32_t* destination) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        store_avx2(destination + i, _mm256_cvtepu16_epi32(load(source + i)));
+        store_avx2(destination + i + 8, _mm256_cvtepu16_epi32(load(source + i + 8)));
+    }
+    return i;
+}
+#endif
+
+template<typename SourceT, typename DestinationT>
+void widen(const SourceT* source, size_t size, DestinationT* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_SIMD_AVX2_DISPATCH)
+    if (tc::infer::cpu::has_avx2())
+        i = widen_avx2(source, size, destination);
+    else
+        i = widen_sse2(source, size, destination);
+#elif defined(TC_INFER_SIMD_SSE2)
+    i = widen_sse2(source, size, destination);
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = static_cast<DestinationT>(source[i]);
+    }
+}
+
+}
+
+void narrow_32_to_16(const uint32_t* source, size_t size, uint16_t* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_SIMD_SSE2)
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i low = low_16_bits(load(source + i));
+        const __m128i high = low_16_bits(load(source + i + 4));
+        store(destination + i, _mm_packs_epi32(low, high));
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = static_cast<uint16_t>(source[i]);
+    }
+}
+
+void narrow_32_to_8(const uint32_t* source, size_t size, uint8_t* destination) noexcept
+{
+    size_t i = 0;
+
+#if defined(TC_INFER_SIMD_SSE2)
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i first = _mm_packs_epi32(low_8_bits(load(source + i)), low_8_bits(load(source + i + 4)));
+        const __m128i second = _mm_packs_epi32(low_8_bits(load(source + i + 8)), low_8_bits(load(source + i + 12)));
+        store(destination + i, _mm_packs_epi16(first, second));
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        destination[i] = static_cast<uint8_t>(source[i]);
+    }
+}
+
+void widen_to_32(const int8_t* source, size_t size, int32_t* destination) noexcept
+{
+    widen(source, size, destination);
+}
+
+void widen_to_32(const uint8_t* source, size_t size, uint32_t* destination) noexcept
+{
+    widen(source, size, destination);
+}
+
+void widen_to_32(const int16_t* source, size_t size, int32_t* destination) noexcept
+{
+    widen(source, size, destination);
+}
+
+void widen_to_32(const uint16_t* source, size_t size, uint32_t* destination) noexcept
+{
+    widen(source, size, destination);
+}
+
+}
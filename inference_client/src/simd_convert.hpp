@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tc::infer::simd
+{
+// Element-wise narrowing of 32 bit integers, keeping the low bits of each element (i.e. static_cast semantics).
+// Signed and unsigned destinations share the same bit patterns, so the same kernels serve int8/uint8 and int16/uint16.
+void narrow_32_to_16(const uint32_t* source, size_t size, uint16_t* destination) noexcept;
+void narrow_32_to_8(const uint32_t* source, size_t size, uint8_t* destination) noexcept;
+
+// Element-wise widening to 32 bit integers, sign or zero extended according to the source type.
+// The AVX2 kernels are selected at runtime when the CPU supports them, SSE2 is the x86-64 baseline.
+void widen_to_32(const int8_t* source, size_t size, int32_t* destination) noexcept;
+void widen_to_32(const uint8_t* source, size_t size, uint32_t* destination) noexcept;
+void widen_to_32(const int16_t* source, size_t size, int32_t* destination) noexcept;
+void widen_to_32(const uint16_t* source, size_t size, uint32_t* destination) noexcept;
+
+}
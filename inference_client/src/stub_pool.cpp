@@ -0,0 +1,102 @@
+#include "stub_pool.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace tc::infer
+{
+stub_pool::lease::lease(const channel_stubs* stubs, std::atomic<int>* in_flight) noexcept
+    : _stubs{ stubs }
+    , _in_flight{ in_flight }
+{
+    _in_flight->fetch_add(1, std::memory_order_relaxed);
+}
+
+stub_pool::lease::lease(lease&& other) noexcept
+    : _stubs{ std::exchange(other._stubs, nullptr) }
+    , _in_flight{ std::exchange(other._in_flight, nullptr) }
+{
+}
+
+auto stub_pool::lease::operator=(lease&& other) noexcept -> lease&
+{
+    if (this != &other)
+    {
+        release();
+        _stubs = std::exchange(other._stubs, nullptr);
+        _in_flight = std::exchange(other._in_flight, nullptr);
+    }
+    return *this;
+}
+
+stub_pool::lease::~lease()
+{
+    release();
+}
+
+void stub_pool::lease::release() noexcept
+{
+    if (_in_flight)
+        _in_flight->fetch_sub(1, std::memory_order_relaxed);
+
+    _stubs = nullptr;
+    _in_flight = nullptr;
+}
+
+stub_pool::stub_pool(std::vector<std::unique_ptr<stub_type>> stubs, tc::infer::channel_selection selection)
+    : _in_flight{ std::make_unique<std::atomic<int>[]>(stubs.size()) }
+    , _selection{ selection }
+{
+    if (stubs.empty())
+        throw std::invalid_argument("stub_pool requires at least one stub");
+
+    _stubs.reserve(stubs.size());
+    for (auto&& stub : stubs)
+    {
+        _stubs.push_back({ std::move(stub), nullptr });
+    }
+}
+
+stub_pool::stub_pool(const std::vector<std::shared_ptr<grpc::ChannelInterface>>& channels, tc::infer::channel_selection selection)
+    : _in_flight{ std::make_unique<std::atomic<int>[]>(channels.size()) }
+    , _selection{ selection }
+{
+    if (channels.empty())
+        throw std::invalid_argument("stub_pool requires at least one channel");
+
+    _stubs.reserve(channels.size());
+    for (auto&& channel : channels)
+    {
+        _stubs.push_back({ inference::GRPCInferenceService::NewStub(channel), std::make_unique<grpc::GenericStub>(channel) });
+    }
+}
+
+auto stub_pool::acquire() -> lease
+{
+    const size_t start = _next_stub.fetch_add(1, std::memory_order_relaxed) % _stubs.size();
+    if (_selection == tc::infer::channel_selection::round_robin || _stubs.size() == 1)
+        return lease(&_stubs[start], &_in_flight[start]);
+
+    // Least loaded channel, ties are broken in round robin order
+    size_t selected = start;
+    int selected_in_flight = _in_flight[start].load(std::memory_order_relaxed);
+    for (size_t i = 1; i < _stubs.size() && selected_in_flight > 0; ++i)
+    {
+        const size_t candidate = (start + i) % _stubs.size();
+        const int candidate_in_flight = _in_flight[candidate].load(std::memory_order_relaxed);
+        if (candidate_in_flight < selected_in_flight)
+        {
+            selected = candidate;
+            selected_in_flight = candidate_in_flight;
+        }
+    }
+
+    return lease(&_stubs[selected], &_in_flight[selected]);
+}
+
+int stub_pool::in_flight(size_t stub_index) const noexcept
+{
+    return _in_flight[stub_index].load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <teiacare/inference_client/client_options.hpp>
+#include <services.grpc.pb.h>
+
+#include <grpcpp/channel.h>
+#include <grpcpp/generic/generic_stub.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tc::infer
+{
+// Set of stubs, one per channel, the RPCs of a client are spread across
+class stub_pool
+{
+public:
+    using stub_type = inference::GRPCInferenceService::StubInterface;
+
+    struct channel_stubs
+    {
+        // Shared with the streams, which can outlive the pool
+        std::shared_ptr<stub_type> stub;
+        // Only available when the pool is created from channels, to send pre-serialized messages
+        std::unique_ptr<grpc::GenericStub> generic_stub;
+    };
+
+    // Stub selected for one RPC: it is accounted as in flight on its channel until the lease is released
+    class lease
+    {
+    public:
+        lease() = default;
+        explicit lease(const channel_stubs* stubs, std::atomic<int>* in_flight) noexcept;
+        lease(lease&& other) noexcept;
+        lease& operator=(lease&& other) noexcept;
+        lease(const lease&) = delete;
+        lease& operator=(const lease&) = delete;
+        ~lease();
+
+        [[nodiscard]]
+        inline stub_type* get() const noexcept
+        {
+            return _stubs ? _stubs->stub.get() : nullptr;
+        }
+
+        [[nodiscard]]
+        inline grpc::GenericStub* generic_stub() const noexcept
+        {
+            return _stubs ? _stubs->generic_stub.get() : nullptr;
+        }
+
+        [[nodiscard]]
+        inline std::shared_ptr<stub_type> shared_stub() const noexcept
+        {
+            return _stubs ? _stubs->stub : nullptr;
+        }
+
+        inline stub_type* operator->() const noexcept
+        {
+            return get();
+        }
+
+        void release() noexcept;
+
+    private:
+        const channel_stubs* _stubs = nullptr;
+        std::atomic<int>* _in_flight = nullptr;
+    };
+
+    explicit stub_pool(std::vector<std::unique_ptr<stub_type>> stubs, tc::infer::channel_selection selection = tc::infer::channel_selection::round_robin);
+    explicit stub_pool(const std::vector<std::shared_ptr<grpc::ChannelInterface>>& channels, tc::infer::channel_selection selection = tc::infer::channel_selection::round_robin);
+
+    [[nodiscard]]
+    lease acquire();
+
+    [[nodiscard]]
+    inline size_t size() const noexcept
+    {
+        return _stubs.size();
+    }
+
+    [[nodiscard]]
+    int in_flight(size_t stub_index) const noexcept;
+
+private:
+    std::vector<channel_stubs> _stubs;
+    std::unique_ptr<std::atomic<int>[]> _in_flight;
+    std::atomic<size_t> _next_stub = 0;
+    const tc::infer::channel_selection _selection;
+};
+
+}
@@ -1,22 +1,167 @@
 #include "tensor_converter.hpp"
+#include "byte_buffer_reader.hpp"
+#include "prepared_request_skeleton.hpp"
+#include "protobuf_arena.hpp"
+#include <algorithm>
 #include <bit>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 
 namespace tc::infer
 {
+namespace
+{
+constexpr uint32_t id_field_number = 3;
+constexpr uint32_t raw_input_contents_field_number = 7;
+constexpr uint32_t raw_output_contents_field_number = 6;
+
+constexpr uint32_t wire_type_varint = 0;
+constexpr uint32_t wire_type_fixed64 = 1;
+constexpr uint32_t wire_type_length_delimited = 2;
+constexpr uint32_t wire_type_fixed32 = 5;
+
+// Inputs smaller than this are copied next to the message header, since a dedicated slice costs more than the copy
+constexpr size_t zero_copy_min_byte_size = 16 * 1024;
+
+// KServe has no typed contents field for FP16 and BF16, so such inputs can only be sent as raw contents
+constexpr bool raw_contents_only(tc::infer::data_type datatype) noexcept
+{
+    return datatype == tc::infer::data_type::Fp16 || datatype == tc::infer::data_type::Bf16;
+}
+
+void append_varint(std::string& buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void append_length_delimited_tag(std::string& buffer, uint32_t field_number, size_t length)
+{
+    append_varint(buffer, (field_number << 3) | wire_type_length_delimited);
+    append_varint(buffer, length);
+}
+
+void append_raw_input_contents(std::string& pending, std::vector<grpc::Slice>& slices, const std::shared_ptr<const std::byte>& data, size_t byte_size)
+{
+    append_length_delimited_tag(pending, raw_input_contents_field_number, byte_size);
+
+    if (byte_size < zero_copy_min_byte_size)
+    {
+        pending.append(std::bit_cast<const char*>(data.get()), byte_size);
+        return;
+    }
+
+    // The slice references the tensor memory and keeps its owner alive until gRPC releases the slice
+    slices.emplace_back(pending);
+    pending.clear();
+
+    auto owner = new std::shared_ptr<const std::byte>(data);
+    slices.emplace_back(
+        const_cast<std::byte*>(data.get()), 
+        byte_size, 
+        [](void* user_data) { delete static_cast<std::shared_ptr<const std::byte>*>(user_data); }, 
+        owner);
+}
+
+void set_shared_memory_parameters(google::protobuf::Map<std::string, inference::InferParameter>* parameters, const tc::infer::shared_memory_binding& shared_memory)
+{
+    (*parameters)["shared_memory_region"].set_string_param(shared_memory.region_name);
+    (*parameters)["shared_memory_byte_size"].set_int64_param(static_cast<int64_t>(shared_memory.byte_size));
+    if (shared_memory.offset != 0)
+        (*parameters)["shared_memory_offset"].set_int64_param(static_cast<int64_t>(shared_memory.offset));
+}
+
+// BYTES elements are length delimited in the tensor data, so their number is only known once they are decoded
+void check_string_element_count(const inference::ModelInferRequest_InferInputTensor& tensor, size_t element_count)
+{
+    const auto decoded_count = static_cast<size_t>(tensor.contents().bytes_contents_size());
+    if (decoded_count != element_count)
+        throw tc::infer::invalid_request_error("BYTES input '" + tensor.name() + "' expects " + std::to_string(element_count) + " elements, got " + std::to_string(decoded_count));
+}
+
+std::optional<tc::infer::shared_memory_binding> get_shared_memory_parameters(const google::protobuf::Map<std::string, inference::InferParameter>& parameters)
+{
+    const auto region = parameters.find("shared_memory_region");
+    if (region == parameters.end())
+        return std::nullopt;
+
+    tc::infer::shared_memory_binding shared_memory { region->second.string_param() };
+    if (const auto byte_size = parameters.find("shared_memory_byte_size"); byte_size != parameters.end())
+        shared_memory.byte_size = static_cast<size_t>(byte_size->second.int64_param());
+
+    if (const auto offset = parameters.find("shared_memory_offset"); offset != parameters.end())
+        shared_memory.offset = static_cast<size_t>(offset->second.int64_param());
+
+    return shared_memory;
+}
+
+}
+
+tensor_converter::tensor_converter(bool raw_input_contents)
+    : _raw_input_contents{ raw_input_contents }
+{
+}
+
 auto tensor_converter::get_infer_request(const tc::infer::infer_request& infer_request) const -> inference::ModelInferRequest
 {
     inference::ModelInferRequest request;
+    set_infer_request(infer_request, request);
+    return request;
+}
+
+auto tensor_converter::get_infer_request(const tc::infer::infer_request& infer_request, google::protobuf::Arena* arena) const -> inference::ModelInferRequest*
+{
+    auto request = google::protobuf::Arena::CreateMessage<inference::ModelInferRequest>(arena);
+    set_infer_request(infer_request, *request);
+    return request;
+}
+
+bool tensor_converter::use_raw_input_contents(const tc::infer::infer_request& infer_request) const
+{
+    // BYTES tensors are only supported through typed contents and FP16/BF16 tensors through raw contents, and the KServe protocol
+    // does not allow mixing raw_input_contents and typed contents within the same request
+    bool has_string_inputs = false;
+    bool has_raw_only_inputs = false;
+    for (const tc::infer::infer_tensor& input : infer_request.input_tensors)
+    {
+        if (input.shared_memory())
+            continue;
+
+        has_string_inputs |= input.datatype() == data_type::String;
+        has_raw_only_inputs |= raw_contents_only(input.datatype());
+    }
+
+    if (has_string_inputs && has_raw_only_inputs)
+        throw tc::infer::invalid_request_error("BYTES and FP16/BF16 inputs cannot be sent in the same request of model '" + infer_request.model_name + "'");
+
+    return has_raw_only_inputs || (_raw_input_contents && !has_string_inputs);
+}
+
+void tensor_converter::set_infer_request(const tc::infer::infer_request& infer_request, inference::ModelInferRequest& request, bool with_raw_input_contents) const
+{
     request.set_model_name(infer_request.model_name);
     request.set_model_version(infer_request.model_version);
     request.set_id(infer_request.id);
     request.mutable_parameters()->clear();
     request.mutable_raw_input_contents()->Clear();
 
+    const bool raw_input_contents = use_raw_input_contents(infer_request);
+    if (raw_input_contents && with_raw_input_contents)
+    {
+        request.mutable_raw_input_contents()->Reserve(static_cast<int>(infer_request.input_tensors.size()));
+    }
+
     for (const tc::infer::infer_tensor& request_input : infer_request.input_tensors)
     {
         inference::ModelInferRequest_InferInputTensor* tensor = request.add_inputs();
         tensor->set_name(request_input.name());
-        tensor->set_datatype(request_input.datatype().str());
+        const std::string_view datatype = request_input.datatype().name();
+        tensor->set_datatype(datatype.data(), datatype.size());
         tensor->mutable_parameters()->clear();
 
         for (auto&& shape : request_input.shape())
@@ -24,25 +169,229 @@ auto tensor_converter::get_infer_request(const tc::infer::infer_request& infer_r
             tensor->add_shape(shape);
         }
 
-        const size_t input_size = request_input.data_size();
+        // Shared memory inputs have neither typed contents nor an entry in raw_input_contents
+        if (request_input.shared_memory())
+        {
+            set_shared_memory_parameters(tensor->mutable_parameters(), *request_input.shared_memory());
+            continue;
+        }
+
+        if (raw_input_contents)
+        {
+            if (with_raw_input_contents)
+                request.add_raw_input_contents(request_input.raw_data(), request_input.byte_size());
+
+            continue;
+        }
+
+        const bool string_input = request_input.datatype() == data_type::String;
+        const size_t input_size = string_input ? request_input.byte_size() : request_input.data_size();
         tensor_data_converter_call_wrapper<tensor_data_writer>(
             request_input.datatype(), 
             tensor, 
             request_input.raw_data(), 
             input_size);
 
-        // DEBUG
-        // auto source_data = request_input.raw_data();
-        // auto data = static_cast<const float*>((void*)source_data);        
-        // // auto contents = tensor->contents().bytes_contents().data();
-        // auto contents = tensor->mutable_contents()->mutable_fp32_contents();
-        // contents->Add(&data[0], &data[0]+input_size);
+        if (string_input)
+            check_string_element_count(*tensor, request_input.data_size());
     }
 
+    for (const tc::infer::requested_output& requested_output : infer_request.requested_outputs)
+    {
+        inference::ModelInferRequest_InferRequestedOutputTensor* output = request.add_outputs();
+        output->set_name(requested_output.name);
+        if (requested_output.shared_memory)
+            set_shared_memory_parameters(output->mutable_parameters(), *requested_output.shared_memory);
+    }
+}
+
+auto tensor_converter::get_infer_request_buffer(const tc::infer::infer_request& infer_request) const -> grpc::ByteBuffer
+{
+    tc::infer::thread_arena_scope arena_scope;
+    auto request = google::protobuf::Arena::CreateMessage<inference::ModelInferRequest>(arena_scope.arena());
+
+    const bool raw_input_contents = use_raw_input_contents(infer_request);
+    set_infer_request(infer_request, *request, false);
+
+    // Protobuf writes the fields in field number order, so appending the raw_input_contents entries (field 7, the last one)
+    // after the serialized header produces the same bytes of ModelInferRequest::SerializeToString
+    std::string pending;
+    request->SerializeToString(&pending);
+
+    std::vector<grpc::Slice> slices;
+    if (raw_input_contents)
+    {
+        for (const tc::infer::infer_tensor& request_input : infer_request.input_tensors)
+        {
+            if (request_input.shared_memory())
+                continue;
+
+            append_raw_input_contents(pending, slices, request_input.shared_data(), request_input.byte_size());
+        }
+    }
+
+    if (!pending.empty())
+        slices.emplace_back(pending);
+
+    return grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+bool tensor_converter::use_raw_input_contents(const tc::infer::prepared_request& prepared_request) const
+{
+    const prepared_request_skeleton& skeleton = prepared_request.skeleton();
+    return skeleton.has_raw_only_inputs || (_raw_input_contents && !skeleton.has_string_inputs);
+}
+
+auto tensor_converter::get_infer_request(const tc::infer::prepared_request& prepared_request, google::protobuf::Arena* arena) const -> inference::ModelInferRequest*
+{
+    const prepared_request_skeleton& skeleton = prepared_request.skeleton();
+    const auto& bound_inputs = prepared_request.bound_inputs();
+    check_bound_inputs(prepared_request);
+
+    auto request = google::protobuf::Arena::CreateMessage<inference::ModelInferRequest>(arena);
+    request->CopyFrom(skeleton.request);
+    request->set_id(prepared_request.id);
+
+    if (use_raw_input_contents(prepared_request))
+    {
+        request->mutable_raw_input_contents()->Reserve(static_cast<int>(bound_inputs.size()));
+        for (const auto& bound_input : bound_inputs)
+        {
+            request->add_raw_input_contents(bound_input.data.get(), bound_input.byte_size);
+        }
+        return request;
+    }
+
+    for (size_t i = 0; i < bound_inputs.size(); ++i)
+    {
+        const bool string_input = skeleton.inputs[i].datatype == data_type::String;
+        inference::ModelInferRequest_InferInputTensor* tensor = request->mutable_inputs(static_cast<int>(i));
+        tensor_data_converter_call_wrapper<tensor_data_writer>(
+            skeleton.inputs[i].datatype, 
+            tensor, 
+            bound_inputs[i].data.get(), 
+            string_input ? bound_inputs[i].byte_size : skeleton.input_element_counts[i]);
+
+        if (string_input)
+            check_string_element_count(*tensor, skeleton.input_element_counts[i]);
+    }
     return request;
 }
 
-auto tensor_converter::get_infer_response(const inference::ModelInferResponse& response) const -> tc::infer::infer_response
+auto tensor_converter::get_infer_request_buffer(const tc::infer::prepared_request& prepared_request) const -> grpc::ByteBuffer
+{
+    if (!use_raw_input_contents(prepared_request))
+    {
+        tc::infer::thread_arena_scope arena_scope;
+        std::string serialized;
+        get_infer_request(prepared_request, arena_scope.arena())->SerializeToString(&serialized);
+
+        grpc::Slice slice(serialized);
+        return grpc::ByteBuffer(&slice, 1);
+    }
+
+    check_bound_inputs(prepared_request);
+
+    // The header was serialized once when the request was prepared. Protobuf parsers accept fields in any order,
+    // so the id is appended after it rather than re-serializing the whole header at each call.
+    std::string pending;
+    pending.reserve(prepared_request.skeleton().header.size() + prepared_request.id.size() + 16 * (prepared_request.bound_inputs().size() + 1));
+    pending.append(prepared_request.skeleton().header);
+    if (!prepared_request.id.empty())
+    {
+        append_length_delimited_tag(pending, id_field_number, prepared_request.id.size());
+        pending.append(prepared_request.id);
+    }
+
+    std::vector<grpc::Slice> slices;
+    for (const auto& bound_input : prepared_request.bound_inputs())
+    {
+        append_raw_input_contents(pending, slices, bound_input.data, bound_input.byte_size);
+    }
+
+    if (!pending.empty())
+        slices.emplace_back(pending);
+
+    return grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+void tensor_converter::check_bound_inputs(const tc::infer::prepared_request& prepared_request) const
+{
+    const auto& bound_inputs = prepared_request.bound_inputs();
+    for (size_t i = 0; i < bound_inputs.size(); ++i)
+    {
+        if (!bound_inputs[i].data)
+            throw std::runtime_error("Input '" + prepared_request.inputs()[i].name + "' of the prepared request is not bound");
+    }
+}
+
+auto tensor_converter::get_infer_response(const std::shared_ptr<const inference::ModelInferResponse>& response) const -> tc::infer::infer_response
+{
+    // Output tensors alias the response buffer and keep the whole response alive, so no bytes are copied
+    std::vector<raw_output_view> raw_outputs;
+    raw_outputs.reserve(response->raw_output_contents_size());
+    for (const std::string& output_content : response->raw_output_contents())
+    {
+        raw_outputs.push_back({ std::shared_ptr<const std::byte>(response, std::bit_cast<const std::byte*>(output_content.data())), output_content.size() });
+    }
+
+    return get_infer_response(*response, raw_outputs);
+}
+
+auto tensor_converter::get_infer_response(grpc::ByteBuffer& buffer) const -> tc::infer::infer_response
+{
+    // Every field but raw_output_contents is re-encoded into a small header message parsed by protobuf,
+    // while raw_output_contents entries are sliced directly from the received buffer
+    tc::infer::byte_buffer_reader reader(buffer);
+    std::string header;
+    std::vector<raw_output_view> raw_outputs;
+
+    while (!reader.at_end())
+    {
+        const uint64_t tag = reader.read_varint();
+        const auto field_number = static_cast<uint32_t>(tag >> 3);
+        const auto wire_type = static_cast<uint32_t>(tag & 0x7);
+
+        if (field_number == raw_output_contents_field_number && wire_type == wire_type_length_delimited)
+        {
+            const auto byte_size = static_cast<size_t>(reader.read_varint());
+            raw_outputs.push_back({ reader.read_bytes(byte_size), byte_size });
+            continue;
+        }
+
+        append_varint(header, tag);
+        switch (wire_type)
+        {
+            case wire_type_varint:
+                append_varint(header, reader.read_varint());
+                break;
+            case wire_type_fixed64:
+                reader.copy_bytes(8, header);
+                break;
+            case wire_type_length_delimited:
+            {
+                const auto byte_size = static_cast<size_t>(reader.read_varint());
+                append_varint(header, byte_size);
+                reader.copy_bytes(byte_size, header);
+                break;
+            }
+            case wire_type_fixed32:
+                reader.copy_bytes(4, header);
+                break;
+            default:
+                throw std::runtime_error("Unsupported wire type in the received ModelInferResponse");
+        }
+    }
+
+    tc::infer::thread_arena_scope arena_scope;
+    auto response = google::protobuf::Arena::CreateMessage<inference::ModelInferResponse>(arena_scope.arena());
+    if (!response->ParseFromString(header))
+        throw std::runtime_error("Unable to parse the received ModelInferResponse");
+
+    return get_infer_response(*response, raw_outputs);
+}
+
+auto tensor_converter::get_infer_response(const inference::ModelInferResponse& response, const std::vector<raw_output_view>& raw_outputs) const -> tc::infer::infer_response
 {
     tc::infer::infer_response infer_response;
     infer_response.model_name = response.model_name();
@@ -50,16 +399,31 @@ auto tensor_converter::get_infer_response(const inference::ModelInferResponse& r
     infer_response.id = response.id();
     infer_response.output_tensors.reserve(response.outputs_size());
 
-    int raw_output_index = 0;
+    size_t raw_output_index = 0;
     for (const inference::ModelInferResponse_InferOutputTensor& response_output : response.outputs())
     {
+        // Shared memory outputs are written by the server into the region and have no entry in raw_output_contents
+        if (auto shared_memory = get_shared_memory_parameters(response_output.parameters()))
+        {
+            infer_response.add_output_tensor(tc::infer::infer_tensor(
+                std::move(*shared_memory),
+                std::vector<int64_t>(response_output.shape().begin(), response_output.shape().end()),
+                tc::infer::data_type(response_output.datatype()), 
+                response_output.name()));
+            continue;
+        }
+
         // Triton Inference Server is only capable to output Raw Output contents instead of using type specific outputs
-        if (response.raw_output_contents_size())
+        if (!raw_outputs.empty())
         {
-            std::string output_content = response.raw_output_contents()[raw_output_index];
+            if (raw_output_index >= raw_outputs.size())
+                throw std::runtime_error("Missing raw_output_contents for output tensor '" + response_output.name() + "'");
+
+            const raw_output_view& output_content = raw_outputs[raw_output_index];
 
             tc::infer::infer_tensor infer_tensor_output(
-                std::vector<std::byte>(std::bit_cast<std::byte*>(output_content.data()), std::bit_cast<std::byte*>(output_content.data() + output_content.size())),
+                output_content.data,
+                output_content.byte_size,
                 std::vector<int64_t>(response_output.shape().begin(), response_output.shape().end()),
                 tc::infer::data_type(response_output.datatype()), 
                 response_output.name()
@@ -70,13 +434,24 @@ auto tensor_converter::get_infer_response(const inference::ModelInferResponse& r
         }
         else
         {
-            // TODO: implement tensor_data_reader to support AMD server
-            // const size_t output_size = std::accumulate(response_output.shape().begin(), response_output.shape().end(), size_t(1), std::multiplies<>());
-            // tensor_data_converter_call_wrapper<tensor_data_reader>(infer_tensor_output.datatype, const_cast<inference::ModelInferResponse_InferOutputTensor*>(&response_output), &infer_tensor_output, output_size);
+            // Typed contents, as sent by servers not supporting raw_output_contents (e.g. AMD Inference Server)
+            const tc::infer::data_type datatype(response_output.datatype());
+            if (datatype == data_type::Unknown)
+                throw std::runtime_error("Unsupported datatype '" + response_output.datatype() + "' in typed contents of output tensor '" + response_output.name() + "'");
+
+            raw_output_view output_content {};
+            tensor_data_converter_call_wrapper<tensor_data_reader>(datatype, &response_output, output_content);
+
+            infer_response.add_output_tensor(tc::infer::infer_tensor(
+                std::move(output_content.data),
+                output_content.byte_size,
+                std::vector<int64_t>(response_output.shape().begin(), response_output.shape().end()),
+                datatype, 
+                response_output.name()));
         }
     }
 
     return infer_response;
 }
 
-}
\ No newline at end of file
+}
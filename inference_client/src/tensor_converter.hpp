@@ -3,8 +3,19 @@
 #include <teiacare/inference_client/data_type.hpp>
 #include <teiacare/inference_client/infer_response.hpp>
 #include <teiacare/inference_client/infer_request.hpp>
+#include <teiacare/inference_client/invalid_request_error.hpp>
+#include <teiacare/inference_client/prepared_request.hpp>
 #include <services.grpc.pb.h>
 
+#include "simd_convert.hpp"
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
 namespace tc::infer::util
 {
     template <typename T, typename... Ts>
@@ -19,8 +30,22 @@ namespace tc::infer
 class tensor_converter
 {
 public:
+    explicit tensor_converter(bool raw_input_contents = true);
+
     auto get_infer_request(const tc::infer::infer_request& infer_request) const -> inference::ModelInferRequest;
-    auto get_infer_response(const inference::ModelInferResponse& response) const -> tc::infer::infer_response;
+    auto get_infer_request(const tc::infer::infer_request& infer_request, google::protobuf::Arena* arena) const -> inference::ModelInferRequest*;
+    void set_infer_request(const tc::infer::infer_request& infer_request, inference::ModelInferRequest& request, bool with_raw_input_contents = true) const;
+
+    // Wire encoding of ModelInferRequest where large raw inputs are slices referencing the tensor memory instead of copies
+    auto get_infer_request_buffer(const tc::infer::infer_request& infer_request) const -> grpc::ByteBuffer;
+
+    // Prepared requests copy their skeleton, or append the bound inputs to its cached wire encoding
+    auto get_infer_request(const tc::infer::prepared_request& prepared_request, google::protobuf::Arena* arena) const -> inference::ModelInferRequest*;
+    auto get_infer_request_buffer(const tc::infer::prepared_request& prepared_request) const -> grpc::ByteBuffer;
+    auto get_infer_response(const std::shared_ptr<const inference::ModelInferResponse>& response) const -> tc::infer::infer_response;
+
+    // Parses the wire encoding of ModelInferResponse: output tensors alias the received slices whenever possible
+    auto get_infer_response(grpc::ByteBuffer& buffer) const -> tc::infer::infer_response;
 
     template<typename T, typename Tensor>
     constexpr static auto getTensorContents(Tensor* tensor)
@@ -29,7 +54,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().bool_contents().data();
+                return &tensor->contents().bool_contents();
             }
             else
             {
@@ -41,7 +66,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().uint_contents().data();
+                return &tensor->contents().uint_contents();
             }
             else
             {
@@ -53,7 +78,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().uint64_contents().data();
+                return &tensor->contents().uint64_contents();
             }
             else
             {
@@ -65,7 +90,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().int_contents().data();
+                return &tensor->contents().int_contents();
             }
             else
             {
@@ -77,7 +102,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().int64_contents().data();
+                return &tensor->contents().int64_contents();
             }
             else
             {
@@ -85,11 +110,19 @@ public:
             }
         }
         
-        if constexpr (util::is_any_v<T, float>) // fp16, 
+        // FP16 and BF16 have no typed contents field: their inputs are always sent as raw contents, while outputs
+        // of servers not supporting raw contents are read from FP32 contents
+        if constexpr (util::is_any_v<T, fp16, bf16>)
+        {
+            static_assert(std::is_const_v<Tensor>, "FP16 and BF16 inputs are always sent as raw contents");
+            return &tensor->contents().fp32_contents();
+        }
+
+        if constexpr (std::is_same_v<T, float>)
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().fp32_contents().data();
+                return &tensor->contents().fp32_contents();
             }
             else
             {
@@ -101,7 +134,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().fp64_contents().data();
+                return &tensor->contents().fp64_contents();
             }
             else
             {
@@ -113,7 +146,7 @@ public:
         {
             if constexpr (std::is_const_v<Tensor>)
             {
-                return tensor->contents().bytes_contents().data();
+                return &tensor->contents().bytes_contents();
             }
             else
             {
@@ -125,6 +158,20 @@ public:
     }
 
 private:
+    struct raw_output_view
+    {
+        std::shared_ptr<const std::byte> data;
+        size_t byte_size;
+    };
+
+    auto get_infer_response(const inference::ModelInferResponse& response, const std::vector<raw_output_view>& raw_outputs) const -> tc::infer::infer_response;
+    bool use_raw_input_contents(const tc::infer::infer_request& infer_request) const;
+    bool use_raw_input_contents(const tc::infer::prepared_request& prepared_request) const;
+    void check_bound_inputs(const tc::infer::prepared_request& prepared_request) const;
+
+    bool _raw_input_contents;
+
+    // The size is the number of elements, or the byte size of the data for BYTES tensors
     template<typename T, typename Tensor>
     struct tensor_data_writer
     {
@@ -135,15 +182,33 @@ private:
 
             if constexpr (std::is_same_v<T, char>)
             {
-                contents->Add(data);
+                // Each element is preceded by its little endian 32 bit length, as in raw BYTES contents
+                size_t offset = 0;
+                while (offset < size)
+                {
+                    if (size - offset < sizeof(uint32_t))
+                        throw tc::infer::invalid_request_error("Truncated element length in BYTES input '" + tensor->name() + "'");
+
+                    uint32_t length = 0;
+                    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+                    {
+                        length |= static_cast<uint32_t>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+                    }
+                    offset += sizeof(uint32_t);
+
+                    if (size - offset < length)
+                        throw tc::infer::invalid_request_error("Truncated element in BYTES input '" + tensor->name() + "'");
+
+                    contents->Add()->assign(data + offset, length);
+                    offset += length;
+                }
+            }
+            else if constexpr (util::is_any_v<T, int8_t, uint8_t, int16_t, uint16_t>)
+            {
+                // Typed contents have no 8 and 16 bit fields: the elements are widened in bulk into the 32 bit field
+                contents->Reserve(contents->size() + static_cast<int>(size));
+                tc::infer::simd::widen_to_32(data, size, contents->AddNAlreadyReserved(static_cast<int>(size)));
             }
-            // else if constexpr (std::is_same_v<T, fp16>)
-            // {
-            //     for (auto i = 0U; i < size; ++i)
-            //     {
-            //         contents->Add(static_cast<float>(data[i]));
-            //     }
-            // }
             else
             {
                 contents->Add(data, data + size);
@@ -156,43 +221,82 @@ private:
         }
     };
 
-/*
+    // FP16 and BF16 have no typed contents field: use_raw_input_contents always sends them as raw contents
+    template<typename T, typename Tensor>
+    requires util::is_any_v<T, fp16, bf16>
+    struct tensor_data_writer<T, Tensor>
+    {
+        void operator()(Tensor*, const void*, size_t) const
+        {
+            throw std::logic_error("FP16 and BF16 inputs cannot be written to typed contents");
+        }
+    };
+
     template<typename T, typename Tensor>
     struct tensor_data_reader
     {
-        // constexpr
-        void operator()(const Tensor* tensor, infer_tensor* output, size_t size) const
+        void operator()(const Tensor* tensor, raw_output_view& output) const
         {
-            const auto bytes_to_copy = size * sizeof(T);
-            std::vector<std::byte> data;
-            data.resize(bytes_to_copy);
             const auto contents = tc::infer::tensor_converter::getTensorContents<T>(tensor);
-            
+
             if constexpr (std::is_same_v<T, char>)
             {
-                std::memcpy(data.data(), contents, size * sizeof(uint8_t));
-                output->data = std::move(data.data());
-                // output->data = data.data();
-                return;
+                // Same layout of raw BYTES contents: each element is preceded by its little endian 32 bit length
+                size_t byte_size = 0;
+                for (const std::string& element : *contents)
+                {
+                    byte_size += sizeof(uint32_t) + element.size();
+                }
+
+                std::shared_ptr<std::byte[]> data(new std::byte[byte_size]);
+                std::byte* destination = data.get();
+                for (const std::string& element : *contents)
+                {
+                    const auto length = static_cast<uint32_t>(element.size());
+                    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+                    {
+                        *destination++ = static_cast<std::byte>(length >> (8 * i));
+                    }
+
+                    std::memcpy(destination, element.data(), element.size());
+                    destination += element.size();
+                }
+
+                output = { std::shared_ptr<const std::byte>(data, data.get()), byte_size };
             }
-            
-            if constexpr (util::is_any_v<T, int8_t, uint8_t, int16_t, uint16_t>) // fp16
+            else
             {
-                for (auto i = 0U; i < size; ++i)
+                // Typed contents store 8 and 16 bit integers widened to 32 bit and FP16/BF16 as FP32, every other type (bool included) has its own width
+                const auto size = static_cast<size_t>(contents->size());
+                std::shared_ptr<std::byte[]> data(new std::byte[size * sizeof(T)]);
+
+                if constexpr (util::is_any_v<T, int8_t, uint8_t>)
                 {
-                    std::memcpy(&(data[i * sizeof(T)]), &(contents[i]), sizeof(T));
+                    tc::infer::simd::narrow_32_to_8(std::bit_cast<const uint32_t*>(contents->data()), size, std::bit_cast<uint8_t*>(data.get()));
+                }
+                else if constexpr (util::is_any_v<T, int16_t, uint16_t>)
+                {
+                    tc::infer::simd::narrow_32_to_16(std::bit_cast<const uint32_t*>(contents->data()), size, std::bit_cast<uint16_t*>(data.get()));
+                }
+                else if constexpr (std::is_same_v<T, fp16>)
+                {
+                    tc::infer::float_to_fp16(contents->data(), size, std::bit_cast<fp16*>(data.get()));
+                }
+                else if constexpr (std::is_same_v<T, bf16>)
+                {
+                    tc::infer::float_to_bf16(contents->data(), size, std::bit_cast<bf16*>(data.get()));
+                }
+                else
+                {
+                    static_assert(sizeof(*contents->data()) == sizeof(T));
+                    if (size > 0)
+                        std::memcpy(data.get(), contents->data(), size * sizeof(T));
                 }
-                output->data = std::move(data.data());
-                // output->data = data.data();
-                return;
-            }
 
-            std::memcpy(data.data(), contents, bytes_to_copy);
-            output->data = std::move(data.data());
-            // output->data = data.data();
+                output = { std::shared_ptr<const std::byte>(data, data.get()), size * sizeof(T) };
+            }
         }
     };
-*/
 
     template<template<typename, typename> class func_t, typename TensorT, typename... Args>
     // constexpr 
@@ -209,7 +313,8 @@ private:
             case data_type::Int16:  return std::invoke(func_t<int16_t, TensorT>(), tensor, args...);
             case data_type::Int32:  return std::invoke(func_t<int32_t, TensorT>(), tensor, args...);
             case data_type::Int64:  return std::invoke(func_t<int64_t, TensorT>(), tensor, args...);
-            case data_type::Fp16:   return; // std::invoke(func_t<uint64_t, TensorT>(), tensor, args...);
+            case data_type::Fp16:   return std::invoke(func_t<fp16, TensorT>(), tensor, args...);
+            case data_type::Bf16:   return std::invoke(func_t<bf16, TensorT>(), tensor, args...);
             case data_type::Fp32:   return std::invoke(func_t<float, TensorT>(), tensor, args...);
             case data_type::Fp64:   return std::invoke(func_t<double, TensorT>(), tensor, args...);
             case data_type::String: return std::invoke(func_t<char, TensorT>(), tensor, args...);
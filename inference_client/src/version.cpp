@@ -0,0 +1,22 @@
+namespace tc::infer::info
+{
+extern const char* const name = "teiacare_inference_client";
+extern const char* const version = "0.1.0";
+
+extern const char* const project_description = "TeiaCareInferenceClient is a C++ inference client library that implements KServe protocol";
+extern const char* const project_url = "https://github.com/TeiaCare/TeiaCareInferenceClient";
+
+extern const char* const build_type = "Release";
+extern const char* const compiler_name = "GNU";
+extern const char* const compiler_version = "12.2.0";
+
+extern const char* const cxx_flags = "";
+extern const char* const cxx_flags_debug = "-g";
+extern const char* const cxx_flags_release = "-O3 -DNDEBUG";
+extern const char* const cxx_standard = "20";
+
+extern const char* const os_name = "Linux";
+extern const char* const os_version = "6.18.44-fc-v130";
+extern const char* const os_processor = "x86_64";
+
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "batching_client.hpp"
+#include "grpc_client.hpp"
+#include "test_models.hpp"
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+class batching_client_test : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        tc::infer::client_options options;
+        options.dynamic_batching = true;
+        options.max_batch_size = 8;
+        options.batching_window = std::chrono::seconds(1);
+
+        _client = std::make_unique<tc::infer::batching_client>(tc::infer::tests::make_stub_client(_server, options), options);
+    }
+
+    static tc::infer::infer_request make_request(std::vector<int32_t> data, int64_t rows, const std::string& model_name = "echo")
+    {
+        const std::string id = "request_" + std::to_string(data.front());
+        const auto columns = static_cast<int64_t>(data.size()) / rows;
+        return tc::infer::tests::make_int32_request(std::move(data), { rows, columns }, model_name, "INPUT0", id);
+    }
+
+    std::vector<std::future<tc::infer::infer_response>> infer_concurrently(const std::vector<tc::infer::infer_request>& requests)
+    {
+        std::vector<std::future<tc::infer::infer_response>> futures;
+        for (const auto& request : requests)
+        {
+            futures.push_back(std::async(std::launch::async, [this, &request] { return _client->infer(request, std::chrono::seconds(5)); }));
+        }
+        return futures;
+    }
+
+    tc::infer::mock::mock_server _server { tc::infer::tests::test_models() };
+    std::unique_ptr<tc::infer::client_interface> _client;
+};
+
+}
+
+TEST_F(batching_client_test, concurrent_requests_are_coalesced)
+{
+    std::vector<tc::infer::infer_request> requests;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        requests.push_back(make_request({ 10 * i, 10 * i + 1, 10 * i + 2, 10 * i + 3 }, 2));
+    }
+
+    auto futures = infer_concurrently(requests);
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        const auto response = futures[i].get();
+        EXPECT_EQ(response.id, requests[i].id);
+        ASSERT_EQ(response.output_tensors.size(), 1U);
+        EXPECT_EQ(response.output_tensors[0].shape(), (std::vector<int64_t>{ 2, 2 }));
+        EXPECT_EQ(response.output_tensors[0].data<int32_t>(), (std::vector<int32_t>{ 10 * i, 10 * i + 1, 10 * i + 2, 10 * i + 3 }));
+    }
+
+    // The batch is full (8 rows) before the batching window expires
+    EXPECT_EQ(_server.infer_count(), 1U);
+}
+
+TEST_F(batching_client_test, incompatible_requests_are_not_coalesced)
+{
+    std::vector<tc::infer::infer_request> requests {
+        make_request({ 1, 2 }, 1),
+        make_request({ 3, 4, 5 }, 1),
+    };
+
+    auto futures = infer_concurrently(requests);
+    EXPECT_EQ(futures[0].get().output_tensors[0].data<int32_t>(), (std::vector<int32_t>{ 1, 2 }));
+    EXPECT_EQ(futures[1].get().output_tensors[0].data<int32_t>(), (std::vector<int32_t>{ 3, 4, 5 }));
+    EXPECT_EQ(_server.infer_count(), 2U);
+}
+
+TEST_F(batching_client_test, full_requests_bypass_batching)
+{
+    const auto response = _client->infer(make_request({ 1, 2, 3, 4, 5, 6, 7, 8 }, 8));
+    EXPECT_EQ(response.output_tensors[0].data<int32_t>(), (std::vector<int32_t>{ 1, 2, 3, 4, 5, 6, 7, 8 }));
+    EXPECT_EQ(_server.infer_count(), 1U);
+}
+
+TEST_F(batching_client_test, errors_are_delivered_to_every_caller)
+{
+    std::vector<tc::infer::infer_request> requests;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        requests.push_back(make_request({ i, i }, 2, "missing"));
+    }
+
+    auto futures = infer_concurrently(requests);
+    for (auto&& future : futures)
+    {
+        EXPECT_THROW(future.get(), std::runtime_error);
+    }
+    EXPECT_EQ(_server.infer_count(), 1U);
+}
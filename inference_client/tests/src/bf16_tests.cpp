@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <teiacare/inference_client/bf16.hpp>
+#include <teiacare/inference_client/fp16.hpp>
+#include <teiacare/inference_client/invalid_request_error.hpp>
+#include "tensor_converter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+TEST(bf16, scalar_conversion)
+{
+    EXPECT_EQ(tc::infer::bf16(0.0f).bits(), 0x0000);
+    EXPECT_EQ(tc::infer::bf16(-0.0f).bits(), 0x8000);
+    EXPECT_EQ(tc::infer::bf16(1.0f).bits(), 0x3F80);
+    EXPECT_EQ(tc::infer::bf16(-2.0f).bits(), 0xC000);
+    EXPECT_EQ(tc::infer::bf16(std::numeric_limits<float>::infinity()).bits(), 0x7F80);
+    EXPECT_EQ(tc::infer::bf16(std::numeric_limits<float>::max()).bits(), 0x7F80);
+
+    // Ties round to the even mantissa
+    EXPECT_EQ(tc::infer::bf16(std::bit_cast<float>(0x3F808000u)).bits(), 0x3F80);
+    EXPECT_EQ(tc::infer::bf16(std::bit_cast<float>(0x3F818000u)).bits(), 0x3F82);
+    EXPECT_EQ(tc::infer::bf16(std::bit_cast<float>(0x3F808001u)).bits(), 0x3F81);
+
+    // A NaN with only low payload bits must not become Inf
+    EXPECT_EQ(tc::infer::bf16(std::bit_cast<float>(0x7F800001u)).bits(), 0x7FC0);
+    EXPECT_EQ(static_cast<float>(tc::infer::bf16::from_bits(0x4049)), 3.140625f);
+
+    static_assert(tc::infer::bf16(1.5f).bits() == 0x3FC0);
+}
+
+TEST(bf16, bulk_conversion_matches_scalar)
+{
+    // Random bit patterns cover NaN, Inf, subnormals and the rounding carries. Odd size, to cover the scalar tail.
+    std::mt19937 generator(42);
+    std::vector<float> source(10007);
+    for (float& value : source)
+    {
+        value = std::bit_cast<float>(static_cast<uint32_t>(generator()));
+    }
+
+    std::vector<tc::infer::bf16> converted(source.size());
+    tc::infer::float_to_bf16(source.data(), source.size(), converted.data());
+
+    std::vector<float> widened(source.size());
+    tc::infer::bf16_to_float(converted.data(), converted.size(), widened.data());
+
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        ASSERT_EQ(converted[i], tc::infer::bf16(source[i])) << std::bit_cast<uint32_t>(source[i]);
+        ASSERT_EQ(std::bit_cast<uint32_t>(widened[i]), std::bit_cast<uint32_t>(static_cast<float>(converted[i])));
+    }
+}
+
+TEST(bf16, data_type)
+{
+    EXPECT_EQ(tc::infer::data_type("BF16"), tc::infer::data_type::Bf16);
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Bf16).str(), "BF16");
+}
+
+TEST(bf16, raw_contents)
+{
+    std::vector<tc::infer::bf16> data { tc::infer::bf16(1.0f), tc::infer::bf16(-2.5f), tc::infer::bf16(0.125f) };
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 3 }, "INPUT0");
+
+    const auto request = tc::infer::tensor_converter(true).get_infer_request(infer_request);
+    EXPECT_EQ(request.inputs(0).datatype(), "BF16");
+    ASSERT_EQ(request.raw_input_contents_size(), 1);
+
+    auto response = std::make_shared<inference::ModelInferResponse>();
+    auto* output = response->add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype("BF16");
+    output->add_shape(3);
+    response->add_raw_output_contents(request.raw_input_contents(0));
+
+    const auto infer_response = tc::infer::tensor_converter().get_infer_response(response);
+    ASSERT_EQ(infer_response.output_tensors.size(), 1U);
+    EXPECT_EQ(infer_response.output_tensors[0].datatype(), tc::infer::data_type::Bf16);
+    EXPECT_EQ(infer_response.output_tensors[0].data<tc::infer::bf16>(), data);
+}
+
+TEST(bf16, typed_mode_sends_raw_contents)
+{
+    std::vector<tc::infer::bf16> data { tc::infer::bf16(1.0f), tc::infer::bf16(-2.5f), tc::infer::bf16(0.125f) };
+    std::vector<tc::infer::fp16> half_data { tc::infer::fp16(1.0f), tc::infer::fp16(-2.5f), tc::infer::fp16(0.125f) };
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 3 }, "INPUT0");
+    infer_request.add_input_tensor(half_data.data(), half_data.size(), { 3 }, "INPUT1");
+
+    // There is no typed contents field for FP16 and BF16
+    const auto request = tc::infer::tensor_converter(false).get_infer_request(infer_request);
+    EXPECT_EQ(request.inputs(0).contents().fp32_contents_size(), 0);
+    EXPECT_EQ(request.inputs(1).contents().fp32_contents_size(), 0);
+    ASSERT_EQ(request.raw_input_contents_size(), 2);
+    EXPECT_EQ(request.raw_input_contents(0).size(), data.size() * sizeof(tc::infer::bf16));
+    EXPECT_EQ(request.raw_input_contents(1).size(), half_data.size() * sizeof(tc::infer::fp16));
+
+    tc::infer::prepared_request prepared("model", "1", { { "INPUT0", { 3 }, tc::infer::data_type::Bf16 } });
+    prepared.set_input(0, std::span<const tc::infer::bf16>(data));
+
+    google::protobuf::Arena arena;
+    const inference::ModelInferRequest* prepared_request = tc::infer::tensor_converter(false).get_infer_request(prepared, &arena);
+    EXPECT_EQ(prepared_request->inputs(0).contents().fp32_contents_size(), 0);
+    ASSERT_EQ(prepared_request->raw_input_contents_size(), 1);
+    EXPECT_EQ(prepared_request->raw_input_contents(0).size(), data.size() * sizeof(tc::infer::bf16));
+}
+
+TEST(bf16, cannot_mix_with_bytes)
+{
+    std::vector<tc::infer::bf16> data { tc::infer::bf16(1.0f) };
+    std::vector<char> bytes { 1, 0, 0, 0, 'a' };
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 1 }, "INPUT0");
+    infer_request.add_input_tensor(bytes.data(), bytes.size(), { 1 }, "INPUT1");
+    EXPECT_THROW(tc::infer::tensor_converter(true).get_infer_request(infer_request), tc::infer::invalid_request_error);
+
+    const std::vector<tc::infer::tensor_spec> inputs { { "INPUT0", { 1 }, tc::infer::data_type::Bf16 }, { "INPUT1", { 1 }, tc::infer::data_type::String } };
+    EXPECT_THROW(tc::infer::prepared_request("model", "1", inputs), tc::infer::invalid_request_error);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <teiacare/inference_client/client_statistics.hpp>
+#include <teiacare/inference_client/mock_server.hpp>
+
+#include <grpcpp/support/status.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+tc::infer::infer_request make_request(const std::string& model_name, std::vector<int32_t>& input0, std::vector<int32_t>& input1)
+{
+    tc::infer::infer_request request;
+    request.model_name = model_name;
+    request.model_version = "1";
+    request.add_input_tensor(input0.data(), input0.size(), { 1, 16 }, "INPUT0");
+    request.add_input_tensor(input1.data(), input1.size(), { 1, 16 }, "INPUT1");
+    return request;
+}
+
+std::optional<tc::infer::model_statistics> find_model(const tc::infer::client_statistics& statistics, const std::string& model_name)
+{
+    for (const tc::infer::model_statistics& model : statistics.models)
+    {
+        if (model.model_name == model_name)
+            return model;
+    }
+    return std::nullopt;
+}
+
+}
+
+TEST(client_statistics, latency_histogram)
+{
+    using histogram = tc::infer::latency_histogram;
+
+    for (int64_t value : { int64_t{0}, int64_t{31}, int64_t{32}, int64_t{1000}, int64_t{123'456'789}, histogram::max_trackable_value })
+    {
+        const std::chrono::nanoseconds upper_bound = histogram::bucket_upper_bound(histogram::bucket_index(value));
+        EXPECT_GE(upper_bound.count(), value);
+        EXPECT_LE(static_cast<double>(upper_bound.count() - value), static_cast<double>(value) / histogram::sub_bucket_count);
+    }
+    EXPECT_EQ(histogram::bucket_index(histogram::max_trackable_value * 2), histogram::bucket_count - 1);
+
+    histogram latencies;
+    for (int64_t i = 1; i <= 100; ++i)
+    {
+        latencies.counts[histogram::bucket_index(i * 1000)] += 1;
+        latencies.count += 1;
+        latencies.sum += std::chrono::microseconds(i);
+        latencies.max = std::chrono::microseconds(i);
+    }
+
+    EXPECT_EQ(latencies.mean(), std::chrono::nanoseconds(50'500));
+    EXPECT_NEAR(static_cast<double>(latencies.percentile(50).count()), 50'000.0, 50'000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(latencies.percentile(99).count()), 99'000.0, 99'000.0 / 16);
+    EXPECT_EQ(latencies.percentile(100), std::chrono::microseconds(100));
+
+    histogram merged;
+    merged.merge(latencies);
+    merged.merge(latencies);
+    EXPECT_EQ(merged.count, 200U);
+    EXPECT_EQ(merged.percentile(50), latencies.percentile(50));
+}
+
+TEST(client_statistics, precise_latency_histogram)
+{
+    // The precision of the benchmark reports, recorded through record() instead of the client shards
+    using histogram = tc::infer::basic_latency_histogram<10, 42>;
+
+    for (int64_t value : { int64_t{0}, int64_t{2047}, int64_t{2048}, int64_t{123'456'789}, histogram::max_trackable_value })
+    {
+        const std::chrono::nanoseconds upper_bound = histogram::bucket_upper_bound(histogram::bucket_index(value));
+        EXPECT_GE(upper_bound.count(), value);
+        EXPECT_LE(static_cast<double>(upper_bound.count() - value), static_cast<double>(value) / histogram::sub_bucket_count);
+    }
+    EXPECT_EQ(histogram::bucket_index(histogram::max_trackable_value * 2), histogram::bucket_count - 1);
+
+    auto latencies = std::make_unique<histogram>();
+    for (int64_t i = 1; i <= 10'000; ++i)
+    {
+        latencies->record(std::chrono::nanoseconds(i * 1000));
+    }
+
+    EXPECT_EQ(latencies->count, 10'000U);
+    EXPECT_EQ(latencies->mean(), std::chrono::nanoseconds(5'000'500));
+    EXPECT_NEAR(static_cast<double>(latencies->percentile(99.99).count()), 9'999'000.0, 9'999'000.0 / 1024);
+    EXPECT_EQ(latencies->percentile(100), std::chrono::milliseconds(10));
+}
+
+TEST(client_statistics, infer)
+{
+    tc::infer::mock::mock_server server;
+    auto client = server.create_client();
+    std::vector<int32_t> input0(16, 1), input1(16, 2);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        client->infer(make_request("simple_int32", input0, input1));
+    }
+    EXPECT_THROW(client->infer(make_request("unknown", input0, input1)), std::runtime_error);
+
+    const tc::infer::client_statistics statistics = client->statistics();
+    ASSERT_EQ(statistics.models.size(), 2U);
+    EXPECT_EQ(statistics.models[0].model_name, "simple_int32");
+    EXPECT_EQ(statistics.models[1].model_name, "unknown");
+
+    const tc::infer::model_statistics& model = statistics.models[0];
+    EXPECT_EQ(model.model_version, "1");
+    EXPECT_EQ(model.request_count, 5U);
+    EXPECT_EQ(model.success_count, 5U);
+    EXPECT_EQ(model.client_error_count, 0U);
+    EXPECT_GT(model.bytes_sent, 5U * 2 * 16 * sizeof(int32_t));
+    EXPECT_GT(model.bytes_received, 5U * 2 * 16 * sizeof(int32_t));
+    EXPECT_EQ(model.latency.count, 5U);
+    EXPECT_EQ(model.rpc_latency.count, 5U);
+    EXPECT_LE(model.rpc_latency.sum, model.latency.sum);
+
+    const tc::infer::model_statistics& unknown = statistics.models[1];
+    EXPECT_EQ(unknown.request_count, 1U);
+    EXPECT_EQ(unknown.success_count, 0U);
+    EXPECT_EQ(unknown.failures_by_status[grpc::StatusCode::NOT_FOUND], 1U);
+    EXPECT_EQ(unknown.timeout_count, 0U);
+}
+
+TEST(client_statistics, failures)
+{
+    tc::infer::mock::mock_server server(tc::infer::mock::mock_server_options{ .service_time = std::chrono::milliseconds(200) });
+    auto client = server.create_client(tc::infer::client_options{ .model_metadata_cache = true });
+    std::vector<int32_t> input0(16, 1), input1(16, 2);
+
+    EXPECT_THROW(client->infer(make_request("simple_int32", input0, input1), std::chrono::milliseconds(20)), tc::infer::timeout_error);
+
+    tc::infer::infer_request invalid_request;
+    invalid_request.model_name = "simple_int32";
+    invalid_request.model_version = "1";
+    invalid_request.add_input_tensor(input0.data(), input0.size(), { 1, 16 }, "INPUT2");
+    EXPECT_THROW(client->infer(invalid_request), tc::infer::invalid_request_error);
+
+    const auto model = find_model(client->statistics(), "simple_int32");
+    ASSERT_TRUE(model.has_value());
+    EXPECT_EQ(model->request_count, 2U);
+    EXPECT_EQ(model->success_count, 0U);
+    EXPECT_EQ(model->timeout_count, 1U);
+    EXPECT_EQ(model->failures_by_status[grpc::StatusCode::DEADLINE_EXCEEDED], 1U);
+    EXPECT_EQ(model->client_error_count, 1U);
+    EXPECT_EQ(model->rpc_latency.count, 1U);
+}
+
+TEST(client_statistics, merges_thread_shards)
+{
+    tc::infer::mock::mock_server server;
+    auto client = server.create_client();
+    auto async_client = server.create_async_client();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&client, &async_client]
+        {
+            std::vector<int32_t> input0(16, 1), input1(16, 2);
+            for (int i = 0; i < 10; ++i)
+            {
+                client->infer(make_request("simple_int32", input0, input1));
+                async_client->infer_async(make_request("simple_int32", input0, input1)).get();
+            }
+        });
+    }
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const tc::infer::client_interface* statistics_client : { static_cast<tc::infer::client_interface*>(client.get()), static_cast<tc::infer::client_interface*>(async_client.get()) })
+    {
+        const auto model = find_model(statistics_client->statistics(), "simple_int32");
+        ASSERT_TRUE(model.has_value());
+        EXPECT_EQ(model->request_count, 40U);
+        EXPECT_EQ(model->success_count, 40U);
+        EXPECT_EQ(model->latency.count, 40U);
+    }
+}
+
+TEST(client_statistics, batching_client)
+{
+    tc::infer::mock::mock_server server;
+    auto client = server.create_client(tc::infer::client_options{ .dynamic_batching = true, .max_batch_size = 2 });
+    std::vector<int32_t> input0(16, 1), input1(16, 2);
+
+    client->infer(make_request("simple_int32", input0, input1));
+
+    const auto model = find_model(client->statistics(), "simple_int32");
+    ASSERT_TRUE(model.has_value());
+    EXPECT_EQ(model->request_count, 1U);
+}
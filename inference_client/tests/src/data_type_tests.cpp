@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <teiacare/inference_client/data_type.hpp>
+
+#include <string>
+
+static_assert(tc::infer::data_type("FP32") == tc::infer::data_type::Fp32);
+static_assert(tc::infer::data_type(tc::infer::data_type::Uint16).name() == "UINT16");
+static_assert(tc::infer::data_type(tc::infer::data_type::Fp64).element_size() == sizeof(double));
+
+// The underlying values of the data types predating BF16 are unchanged
+static_assert(tc::infer::data_type::Fp32 == 10 && tc::infer::data_type::Fp64 == 11 && tc::infer::data_type::String == 12);
+static_assert(tc::infer::data_type(tc::infer::data_type::Bf16).name() == "BF16");
+
+TEST(data_type, name_round_trip)
+{
+    for (int type = tc::infer::data_type::Bool; type < tc::infer::data_type::Unknown; ++type)
+    {
+        const tc::infer::data_type datatype(static_cast<tc::infer::data_type::value>(type));
+        EXPECT_EQ(tc::infer::data_type::from_string(datatype.name()), datatype) << datatype.str();
+        EXPECT_EQ(tc::infer::data_type(datatype.str()), datatype);
+    }
+
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::String).str(), "BYTES");
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Unknown).str(), "Unknown");
+}
+
+TEST(data_type, unknown_names)
+{
+    for (const std::string name : { "", "FP", "UINT", "INT", "INT7", "UINT128", "FP32X", "fp32", "BYTE", "BOOLEAN", "BF32", "STRING", "Unknown" })
+    {
+        EXPECT_EQ(tc::infer::data_type(name), tc::infer::data_type::Unknown) << name;
+    }
+}
+
+TEST(data_type, element_size)
+{
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Bool).element_size(), sizeof(bool));
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Int16).element_size(), sizeof(int16_t));
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Bf16).element_size(), sizeof(tc::infer::bf16));
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Uint64).element_size(), sizeof(uint64_t));
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::String).element_size(), 0U);
+    EXPECT_EQ(tc::infer::data_type(tc::infer::data_type::Unknown).element_size(), 0U);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <teiacare/inference_client/fp16.hpp>
+#include <teiacare/inference_client/invalid_request_error.hpp>
+#include "tensor_converter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST(fp16, scalar_conversion)
+{
+    EXPECT_EQ(tc::infer::fp16(0.0f).bits(), 0x0000);
+    EXPECT_EQ(tc::infer::fp16(-0.0f).bits(), 0x8000);
+    EXPECT_EQ(tc::infer::fp16(1.0f).bits(), 0x3C00);
+    EXPECT_EQ(tc::infer::fp16(-2.0f).bits(), 0xC000);
+    EXPECT_EQ(tc::infer::fp16(65504.0f).bits(), 0x7BFF);
+    EXPECT_EQ(tc::infer::fp16(65520.0f).bits(), 0x7C00);
+    EXPECT_EQ(tc::infer::fp16(std::numeric_limits<float>::infinity()).bits(), 0x7C00);
+    EXPECT_EQ(tc::infer::fp16(std::ldexp(1.0f, -14)).bits(), 0x0400);
+    EXPECT_EQ(tc::infer::fp16(std::ldexp(1.0f, -24)).bits(), 0x0001);
+    EXPECT_EQ(tc::infer::fp16(std::ldexp(1.0f, -25)).bits(), 0x0000);
+
+    // Ties round to the even mantissa
+    EXPECT_EQ(tc::infer::fp16(1.0f + std::ldexp(1.0f, -11)).bits(), 0x3C00);
+    EXPECT_EQ(tc::infer::fp16(1.0f + 3 * std::ldexp(1.0f, -11)).bits(), 0x3C02);
+
+    EXPECT_TRUE(std::isnan(static_cast<float>(tc::infer::fp16(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_EQ(static_cast<float>(tc::infer::fp16::from_bits(0x3555)), 0.333251953125f);
+
+    static_assert(tc::infer::fp16(1.5f).bits() == 0x3E00);
+}
+
+TEST(fp16, every_value_round_trips)
+{
+    std::vector<tc::infer::fp16> values;
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        values.push_back(tc::infer::fp16::from_bits(static_cast<uint16_t>(bits)));
+    }
+
+    std::vector<float> widened(values.size());
+    tc::infer::fp16_to_float(values.data(), values.size(), widened.data());
+
+    std::vector<tc::infer::fp16> narrowed(values.size());
+    tc::infer::float_to_fp16(widened.data(), widened.size(), narrowed.data());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(std::bit_cast<uint32_t>(widened[i]), std::bit_cast<uint32_t>(static_cast<float>(values[i]))) << "bits " << i;
+
+        // Signaling NaNs become quiet through the conversion
+        const bool nan = (i & 0x7C00) == 0x7C00 && (i & 0x3FF) != 0;
+        ASSERT_EQ(narrowed[i].bits(), nan ? (i | 0x200) : i) << "bits " << i;
+    }
+}
+
+TEST(fp16, bulk_conversion_matches_scalar)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-70000.0f, 70000.0f);
+
+    // Odd size, to cover the scalar tail after the vectorized loop
+    std::vector<float> source(10007);
+    for (float& value : source)
+    {
+        value = distribution(generator) * std::ldexp(1.0f, static_cast<int>(generator() % 40) - 30);
+    }
+
+    std::vector<tc::infer::fp16> converted(source.size());
+    tc::infer::float_to_fp16(source.data(), source.size(), converted.data());
+
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        ASSERT_EQ(converted[i], tc::infer::fp16(source[i])) << source[i];
+    }
+}
+
+TEST(fp16, raw_input_contents)
+{
+    std::vector<tc::infer::fp16> data { tc::infer::fp16(1.0f), tc::infer::fp16(-2.5f), tc::infer::fp16(0.125f) };
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 3 }, "INPUT0");
+
+    const auto request = tc::infer::tensor_converter(true).get_infer_request(infer_request);
+    EXPECT_EQ(request.inputs(0).datatype(), "FP16");
+    ASSERT_EQ(request.raw_input_contents_size(), 1);
+    EXPECT_EQ(request.raw_input_contents(0).size(), data.size() * sizeof(tc::infer::fp16));
+}
+
+TEST(fp16, typed_mode_sends_raw_contents)
+{
+    std::vector<tc::infer::fp16> data { tc::infer::fp16(1.0f), tc::infer::fp16(-2.5f), tc::infer::fp16(0.125f) };
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 3 }, "INPUT0");
+
+    // There is no typed contents field for FP16
+    const auto request = tc::infer::tensor_converter(false).get_infer_request(infer_request);
+    EXPECT_EQ(request.inputs(0).contents().fp32_contents_size(), 0);
+    ASSERT_EQ(request.raw_input_contents_size(), 1);
+    EXPECT_EQ(request.raw_input_contents(0).size(), data.size() * sizeof(tc::infer::fp16));
+}
+
+TEST(fp16, cannot_mix_with_bytes)
+{
+    std::vector<tc::infer::fp16> data { tc::infer::fp16(1.0f) };
+    std::vector<char> bytes { 1, 0, 0, 0, 'a' };
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 1 }, "INPUT0");
+    infer_request.add_input_tensor(bytes.data(), bytes.size(), { 1 }, "INPUT1");
+    EXPECT_THROW(tc::infer::tensor_converter(true).get_infer_request(infer_request), tc::infer::invalid_request_error);
+
+    const std::vector<tc::infer::tensor_spec> inputs { { "INPUT0", { 1 }, tc::infer::data_type::Fp16 }, { "INPUT1", { 1 }, tc::infer::data_type::String } };
+    EXPECT_THROW(tc::infer::prepared_request("model", "1", inputs), tc::infer::invalid_request_error);
+}
+
+TEST(fp16, fp32_output_contents)
+{
+    const std::vector<tc::infer::fp16> data { tc::infer::fp16(1.0f), tc::infer::fp16(-2.5f), tc::infer::fp16(0.125f) };
+
+    // Servers not supporting raw contents send FP16 outputs as FP32 contents
+    auto response = std::make_shared<inference::ModelInferResponse>();
+    auto* output = response->add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype("FP16");
+    output->add_shape(3);
+    for (tc::infer::fp16 value : data)
+    {
+        output->mutable_contents()->add_fp32_contents(static_cast<float>(value));
+    }
+
+    const auto infer_response = tc::infer::tensor_converter().get_infer_response(response);
+    ASSERT_EQ(infer_response.output_tensors.size(), 1U);
+    EXPECT_EQ(infer_response.output_tensors[0].datatype(), tc::infer::data_type::Fp16);
+    EXPECT_EQ(infer_response.output_tensors[0].data<tc::infer::fp16>(), data);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "grpc_client_async.hpp"
+#include "test_models.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Fire-and-forget coroutine type, enough to drive the awaitables from a test
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+class grpc_client_async_test : public testing::Test
+{
+protected:
+    tc::infer::mock::mock_server _server { tc::infer::tests::test_models() };
+    std::unique_ptr<tc::infer::async_client_interface> _client = tc::infer::tests::make_stub_client<tc::infer::grpc_client_async>(_server, tc::infer::client_options{ .completion_queue_threads = 2 });
+};
+
+}
+
+TEST_F(grpc_client_async_test, infer_async_future)
+{
+    const std::vector<int32_t> data { 1, 2, 3, 4 };
+    auto future = _client->infer_async(tc::infer::tests::make_echo_request(data));
+
+    const auto response = future.get();
+    EXPECT_EQ(response.model_name, "echo");
+    ASSERT_EQ(response.output_tensors.size(), 1U);
+    EXPECT_EQ(response.output_tensors[0].data<int32_t>(), data);
+}
+
+TEST_F(grpc_client_async_test, infer_async_callback)
+{
+    const std::vector<int32_t> data { 5, 6, 7, 8 };
+    constexpr int num_requests = 64;
+
+    std::atomic<int> completed = 0;
+    std::promise<void> done;
+    for (int i = 0; i < num_requests; ++i)
+    {
+        _client->infer_async(tc::infer::tests::make_echo_request(data), [&](tc::infer::infer_response response, std::exception_ptr error)
+        {
+            EXPECT_FALSE(error);
+            EXPECT_EQ(response.output_tensors[0].data<int32_t>(), data);
+            if (++completed == num_requests)
+                done.set_value();
+        });
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(completed, num_requests);
+}
+
+TEST_F(grpc_client_async_test, infer_async_error)
+{
+    auto future = _client->infer_async(tc::infer::tests::make_echo_request({ 1 }, "missing"));
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST_F(grpc_client_async_test, infer_async_timeout)
+{
+    auto future = _client->infer_async(tc::infer::tests::make_echo_request({ 1 }, "slow"), std::chrono::milliseconds(10));
+    EXPECT_THROW(future.get(), tc::infer::timeout_error);
+}
+
+TEST_F(grpc_client_async_test, sync_calls_are_still_available)
+{
+    const std::vector<int32_t> data { 9, 10 };
+    const auto response = _client->infer(tc::infer::tests::make_echo_request(data));
+    EXPECT_EQ(response.output_tensors[0].data<int32_t>(), data);
+}
+
+TEST_F(grpc_client_async_test, coroutine_calls)
+{
+    struct coroutine_result
+    {
+        bool ready = false;
+        bool missing_ready = true;
+        tc::infer::model_metadata metadata;
+        std::vector<int32_t> output;
+        bool metadata_error = false;
+    };
+
+    auto run = [](tc::infer::async_client_interface* client, std::vector<int32_t> data, std::promise<coroutine_result>& done) -> detached_task
+    {
+        coroutine_result result;
+        result.ready = co_await client->is_model_ready_co("echo", "1");
+        result.missing_ready = co_await client->is_model_ready_co("missing", "1");
+        result.metadata = co_await client->model_metadata_co("echo", "1");
+
+        auto response = co_await client->infer_co(tc::infer::tests::make_echo_request(data));
+        result.output = response.output_tensors[0].data<int32_t>();
+
+        try
+        {
+            co_await client->model_metadata_co("missing", "1");
+        }
+        catch(const std::runtime_error&)
+        {
+            result.metadata_error = true;
+        }
+
+        done.set_value(std::move(result));
+    };
+
+    const std::vector<int32_t> data { 3, 1, 4, 1, 5 };
+    std::promise<coroutine_result> done;
+    run(_client.get(), data, done);
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    const auto result = future.get();
+    EXPECT_TRUE(result.ready);
+    EXPECT_FALSE(result.missing_ready);
+    EXPECT_EQ(result.metadata.model_name, "echo");
+    ASSERT_EQ(result.metadata.inputs.size(), 1U);
+    EXPECT_EQ(result.metadata.inputs[0].shape, (std::vector<int64_t>{ 1, -1 }));
+    EXPECT_EQ(result.output, data);
+    EXPECT_TRUE(result.metadata_error);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "grpc_client.hpp"
+#include "test_models.hpp"
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+namespace
+{
+class grpc_infer_stream_test : public testing::Test
+{
+protected:
+    tc::infer::mock::mock_server _server { tc::infer::tests::test_models() };
+    std::unique_ptr<tc::infer::client_interface> _client = tc::infer::tests::make_stub_client(_server);
+};
+
+}
+
+TEST_F(grpc_infer_stream_test, pipelined_requests)
+{
+    constexpr int num_requests = 128;
+    auto stream = _client->create_infer_stream();
+
+    std::vector<std::future<tc::infer::infer_response>> futures;
+    for (int i = 0; i < num_requests; ++i)
+    {
+        futures.push_back(stream->infer(tc::infer::tests::make_echo_request({ i, i + 1 })));
+    }
+
+    for (int i = 0; i < num_requests; ++i)
+    {
+        ASSERT_EQ(futures[i].wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        const auto response = futures[i].get();
+        ASSERT_EQ(response.output_tensors.size(), 1U);
+        EXPECT_EQ(response.output_tensors[0].data<int32_t>(), (std::vector<int32_t>{ i, i + 1 }));
+    }
+}
+
+TEST_F(grpc_infer_stream_test, request_id_is_preserved)
+{
+    auto stream = _client->create_infer_stream();
+    const auto response = stream->infer(tc::infer::tests::make_echo_request({ 1 }, "echo", "my_id")).get();
+    EXPECT_EQ(response.id, "my_id");
+}
+
+TEST_F(grpc_infer_stream_test, duplicated_request_id)
+{
+    auto stream = _client->create_infer_stream();
+    auto slow = stream->infer(tc::infer::tests::make_echo_request({ 1 }, "slow", "same_id"));
+    EXPECT_THROW(stream->infer(tc::infer::tests::make_echo_request({ 1 }, "echo", "same_id")), std::runtime_error);
+    EXPECT_NO_THROW(slow.get());
+}
+
+TEST_F(grpc_infer_stream_test, error_message_fails_only_its_request)
+{
+    auto stream = _client->create_infer_stream();
+    auto missing = stream->infer(tc::infer::tests::make_echo_request({ 1 }, "missing"));
+    auto echo = stream->infer(tc::infer::tests::make_echo_request({ 2 }));
+
+    EXPECT_THROW(missing.get(), std::runtime_error);
+    EXPECT_EQ(echo.get().output_tensors[0].data<int32_t>(), std::vector<int32_t>{ 2 });
+}
+
+TEST_F(grpc_infer_stream_test, closed_stream_fails_pending_requests)
+{
+    auto stream = _client->create_infer_stream();
+    auto closing = stream->infer(tc::infer::tests::make_echo_request({ 1 }, "close"));
+    EXPECT_THROW(closing.get(), std::runtime_error);
+}
+
+TEST_F(grpc_infer_stream_test, stream_outlives_client)
+{
+    auto stream = _client->create_infer_stream();
+    _client.reset();
+
+    EXPECT_EQ(stream->infer(tc::infer::tests::make_echo_request({ 3 })).get().output_tensors[0].data<int32_t>(), std::vector<int32_t>{ 3 });
+}
+
+TEST_F(grpc_infer_stream_test, destructor_cancels_stalled_stream)
+{
+    auto client = tc::infer::tests::make_stub_client(_server, tc::infer::client_options{ .rpc_timeout = std::chrono::milliseconds(20) });
+    auto stream = client->create_infer_stream();
+    auto slow = stream->infer(tc::infer::tests::make_echo_request({ 1 }, "slow"));
+
+    stream.reset();
+    ASSERT_EQ(slow.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_THROW(slow.get(), std::runtime_error);
+}
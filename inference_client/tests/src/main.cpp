@@ -15,6 +15,15 @@ public:
         grpc::ClientContext context;
 
         const grpc::Status rpc_status = _stub->ServerLive(&context, request, &response);
+        switch(rpc_status.error_code())
+        {
+            case grpc::StatusCode::OK:
+                break;
+            case grpc::StatusCode::DEADLINE_EXCEEDED:
+                throw tc::infer::timeout_error(rpc_status.error_message());
+            default:
+                throw std::runtime_error(rpc_status.error_message());
+        }
 
         return response.live();
     }
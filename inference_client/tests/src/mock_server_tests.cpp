@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <teiacare/inference_client/client_factory.hpp>
+#include <teiacare/inference_client/mock_server.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+template<typename T>
+tc::infer::infer_request make_add_sub_request(const std::string& model_name, std::vector<T>& input0, std::vector<T>& input1)
+{
+    tc::infer::infer_request request;
+    request.model_name = model_name;
+    request.model_version = "1";
+    request.add_input_tensor(input0.data(), input0.size(), { 1, 16 }, "INPUT0");
+    request.add_input_tensor(input1.data(), input1.size(), { 1, 16 }, "INPUT1");
+    return request;
+}
+
+template<typename T>
+void expect_add_sub(const tc::infer::infer_response& response, const std::vector<T>& input0, const std::vector<T>& input1)
+{
+    ASSERT_EQ(response.output_tensors.size(), 2U);
+    const auto sum = response.output_tensors[0].template data<T>();
+    const auto difference = response.output_tensors[1].template data<T>();
+    for (size_t i = 0; i < input0.size(); ++i)
+    {
+        EXPECT_EQ(sum[i], input0[i] + input1[i]);
+        EXPECT_EQ(difference[i], input0[i] - input1[i]);
+    }
+}
+
+}
+
+TEST(mock_server, add_sub_models)
+{
+    tc::infer::mock::mock_server server;
+    std::vector<int32_t> int_input0(16), int_input1(16, 3);
+    std::vector<float> float_input0(16), float_input1(16, 0.5f);
+    for (size_t i = 0; i < 16; ++i)
+    {
+        int_input0[i] = static_cast<int32_t>(i);
+        float_input0[i] = static_cast<float>(i);
+    }
+
+    // Raw and typed input contents
+    for (bool raw_input_contents : { true, false })
+    {
+        auto client = server.create_client(tc::infer::client_options{ .raw_input_contents = raw_input_contents });
+        expect_add_sub(client->infer(make_add_sub_request("simple_int32", int_input0, int_input1)), int_input0, int_input1);
+        expect_add_sub(client->infer(make_add_sub_request("simple_fp32", float_input0, float_input1)), float_input0, float_input1);
+    }
+
+    EXPECT_EQ(server.infer_count(), 4U);
+
+    auto client = server.create_client();
+    EXPECT_THROW(client->infer(make_add_sub_request("simple_fp32", int_input0, int_input1)), std::runtime_error);
+
+    const tc::infer::model_metadata metadata = client->model_metadata("simple_int32", "1");
+    ASSERT_EQ(metadata.inputs.size(), 2U);
+    EXPECT_EQ(metadata.inputs[1].datatype, "INT32");
+    EXPECT_EQ(metadata.inputs[1].shape, (std::vector<int64_t>{ -1, 16 }));
+}
+
+TEST(mock_server, model_repository)
+{
+    tc::infer::mock::mock_server server(tc::infer::mock::mock_server_options{ .models = { { "echo_int8", tc::infer::mock::model_kind::echo, tc::infer::data_type::Int8, { -1 } } } });
+    auto client = server.create_client();
+
+    EXPECT_EQ(client->model_list(), std::vector<std::string>{ "echo_int8" });
+    EXPECT_TRUE(client->is_model_ready("echo_int8", "1"));
+    EXPECT_FALSE(client->is_model_ready("simple_int32", "1"));
+
+    std::vector<int8_t> data { 1, -2, 3 };
+    tc::infer::infer_request request;
+    request.model_name = "echo_int8";
+    request.add_input_tensor(data.data(), data.size(), { 3 }, "INPUT0");
+    EXPECT_EQ(client->infer(request).output_tensors[0].data<int8_t>(), data);
+
+    client->model_unload("echo_int8", "");
+    EXPECT_FALSE(client->is_model_ready("echo_int8", "1"));
+    EXPECT_THROW(client->infer(request), std::runtime_error);
+
+    client->model_load("echo_int8", "");
+    EXPECT_EQ(client->infer(request).output_tensors[0].data<int8_t>(), data);
+}
+
+TEST(mock_server, listening_port)
+{
+    tc::infer::mock::mock_server server(tc::infer::mock::mock_server_options{ .address = "127.0.0.1:0" });
+    ASSERT_FALSE(server.uri().empty());
+    EXPECT_NE(server.uri(), "127.0.0.1:0");
+
+    auto client = tc::infer::create_client(server.uri());
+    EXPECT_TRUE(client->is_server_live());
+    EXPECT_EQ(client->server_metadata().server_name, "teiacare_mock_server");
+}
+
+TEST(mock_server, service_time)
+{
+    tc::infer::mock::mock_server server(tc::infer::mock::mock_server_options{ .service_time = std::chrono::milliseconds(20) });
+    auto client = server.create_client();
+
+    std::vector<int32_t> input0(16, 1), input1(16, 2);
+    auto start = std::chrono::steady_clock::now();
+    static_cast<void>(client->infer(make_add_sub_request("simple_int32", input0, input1)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    server.set_service_time(std::chrono::microseconds(0));
+    start = std::chrono::steady_clock::now();
+    static_cast<void>(client->infer(make_add_sub_request("simple_int32", input0, input1)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST(mock_server, shutdown_with_open_stream)
+{
+    auto server = std::make_unique<tc::infer::mock::mock_server>();
+    auto client = server->create_client();
+    auto stream = client->create_infer_stream();
+
+    std::vector<int32_t> input0(16, 1), input1(16, 2);
+    static_cast<void>(stream->infer(make_add_sub_request("simple_int32", input0, input1)).get());
+
+    // The stream handler is blocked reading the next request: the server is destroyed before the stream anyway
+    const auto start = std::chrono::steady_clock::now();
+    server.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "grpc_client.hpp"
+#include "grpc_client_async.hpp"
+#include "test_models.hpp"
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace
+{
+class model_metadata_cache_test : public testing::Test
+{
+protected:
+    std::unique_ptr<tc::infer::client_interface> make_client(std::chrono::milliseconds ttl = std::chrono::seconds(60))
+    {
+        return tc::infer::tests::make_stub_client(_server, tc::infer::client_options{ .model_metadata_cache = true, .model_metadata_ttl = ttl });
+    }
+
+    tc::infer::mock::mock_server _server { tc::infer::tests::test_models() };
+};
+
+}
+
+TEST_F(model_metadata_cache_test, cached_metadata)
+{
+    auto client = make_client();
+    EXPECT_EQ(client->model_metadata("echo", "1").inputs.size(), 1U);
+    EXPECT_EQ(client->model_metadata("echo", "1").inputs[0].name, "INPUT0");
+    EXPECT_EQ(_server.metadata_count(), 1U);
+
+    // Each version is cached on its own, model_load and model_unload drop all of them
+    static_cast<void>(client->model_metadata("echo", "2"));
+    EXPECT_EQ(_server.metadata_count(), 2U);
+
+    client->model_load("echo", "");
+    static_cast<void>(client->model_metadata("echo", "1"));
+    static_cast<void>(client->model_metadata("echo", "2"));
+    EXPECT_EQ(_server.metadata_count(), 4U);
+
+    // The unloaded model is not served from the cache anymore
+    client->model_unload("echo", "");
+    EXPECT_THROW(static_cast<void>(client->model_metadata("echo", "1")), std::runtime_error);
+    EXPECT_EQ(_server.metadata_count(), 5U);
+
+    EXPECT_THROW(static_cast<void>(client->model_metadata("missing", "1")), std::runtime_error);
+}
+
+TEST_F(model_metadata_cache_test, expired_metadata)
+{
+    auto client = make_client(std::chrono::milliseconds(1));
+    static_cast<void>(client->model_metadata("echo", "1"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    static_cast<void>(client->model_metadata("echo", "1"));
+    EXPECT_EQ(_server.metadata_count(), 2U);
+}
+
+TEST_F(model_metadata_cache_test, request_validation)
+{
+    auto client = make_client();
+    std::vector<int32_t> data { 1, 2, 3, 4 };
+    std::vector<float> float_data { 1.0f, 2.0f, 3.0f, 4.0f };
+
+    // The model metadata declares INPUT0 as INT32 [1,-1]
+    EXPECT_EQ(client->infer(tc::infer::tests::make_int32_request(data, { 1, 4 })).output_tensors[0].data<int32_t>(), data);
+    EXPECT_EQ(_server.infer_count(), 1U);
+
+    EXPECT_THROW(client->infer(tc::infer::tests::make_int32_request(data, { 1, 4 }, "echo", "INPUT1")), tc::infer::invalid_request_error);
+    EXPECT_THROW(client->infer(tc::infer::tests::make_int32_request(data, { 2, 2 })), tc::infer::invalid_request_error);
+    EXPECT_THROW(client->infer(tc::infer::tests::make_int32_request(data, { 4 })), tc::infer::invalid_request_error);
+
+    tc::infer::infer_request float_request;
+    float_request.model_name = "echo";
+    float_request.model_version = "1";
+    float_request.add_input_tensor(float_data.data(), float_data.size(), { 1, 4 }, "INPUT0");
+    EXPECT_THROW(client->infer(float_request), tc::infer::invalid_request_error);
+
+    tc::infer::prepared_request prepared_request("echo", "1", { { "INPUT0", { 4, 1 }, tc::infer::data_type::Int32 } });
+    prepared_request.set_input(0, std::span<const int32_t>(data));
+    EXPECT_THROW(client->infer(prepared_request), tc::infer::invalid_request_error);
+
+    EXPECT_EQ(_server.infer_count(), 1U);
+    EXPECT_EQ(_server.metadata_count(), 1U);
+}
+
+TEST_F(model_metadata_cache_test, async_invalid_request)
+{
+    std::unique_ptr<tc::infer::async_client_interface> client = tc::infer::tests::make_stub_client<tc::infer::grpc_client_async>(_server, tc::infer::client_options{ .model_metadata_cache = true });
+    static_cast<void>(client->model_metadata("echo", "1"));
+    std::vector<int32_t> data { 1, 2, 3, 4 };
+
+    // Validation failures are delivered as the call result, not thrown by infer_async
+    std::future<tc::infer::infer_response> future;
+    EXPECT_NO_THROW(future = client->infer_async(tc::infer::tests::make_int32_request(data, { 1, 4 }, "echo", "INPUT1")));
+    EXPECT_THROW(future.get(), tc::infer::invalid_request_error);
+
+    std::exception_ptr callback_error;
+    client->infer_async(tc::infer::tests::make_int32_request(data, { 4 }), [&callback_error](tc::infer::infer_response, std::exception_ptr error) { callback_error = error; });
+    ASSERT_TRUE(callback_error);
+    EXPECT_THROW(std::rethrow_exception(callback_error), tc::infer::invalid_request_error);
+
+    EXPECT_EQ(_server.infer_count(), 0U);
+}
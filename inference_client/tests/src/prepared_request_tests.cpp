@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <teiacare/inference_client/invalid_request_error.hpp>
+#include <teiacare/inference_client/prepared_request.hpp>
+#include "grpc_client.hpp"
+#include "tensor_converter.hpp"
+#include "test_models.hpp"
+
+#include <google/protobuf/arena.h>
+#include <google/protobuf/util/message_differencer.h>
+
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace
+{
+tc::infer::prepared_request make_prepared_request()
+{
+    return tc::infer::prepared_request("echo", "1", { { "INPUT0", { 1, 4 }, tc::infer::data_type::Int32 }, { "INPUT1", { 2 }, tc::infer::data_type::Fp32 } }, { "OUTPUT0", "OUTPUT1" });
+}
+
+std::string serialize(const grpc::ByteBuffer& buffer)
+{
+    std::vector<grpc::Slice> slices;
+    EXPECT_TRUE(buffer.Dump(&slices).ok());
+
+    std::string serialized;
+    for (const grpc::Slice& slice : slices)
+    {
+        serialized.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+    }
+    return serialized;
+}
+
+}
+
+TEST(prepared_request, matches_infer_request)
+{
+    std::vector<int32_t> input0 { 1, 2, 3, 4 };
+    std::vector<float> input1 { 0.5f, -1.5f };
+
+    tc::infer::infer_request infer_request;
+    infer_request.model_name = "echo";
+    infer_request.model_version = "1";
+    infer_request.id = "request_0";
+    infer_request.add_input_tensor(input0.data(), input0.size(), { 1, 4 }, "INPUT0");
+    infer_request.add_input_tensor(input1.data(), input1.size(), { 2 }, "INPUT1");
+    infer_request.add_requested_output("OUTPUT0");
+    infer_request.add_requested_output("OUTPUT1");
+
+    tc::infer::prepared_request prepared_request = make_prepared_request();
+    prepared_request.id = "request_0";
+    prepared_request.set_input(0, std::span<const int32_t>(input0));
+    prepared_request.set_input(prepared_request.input_index("INPUT1"), std::span<const float>(input1));
+
+    for (bool raw_input_contents : { true, false })
+    {
+        const tc::infer::tensor_converter converter(raw_input_contents);
+        const inference::ModelInferRequest expected = converter.get_infer_request(infer_request);
+
+        google::protobuf::Arena arena;
+        EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(*converter.get_infer_request(prepared_request, &arena), expected));
+
+        inference::ModelInferRequest parsed;
+        ASSERT_TRUE(parsed.ParseFromString(serialize(converter.get_infer_request_buffer(prepared_request))));
+        EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(parsed, expected));
+    }
+}
+
+TEST(prepared_request, invalid_inputs)
+{
+    tc::infer::prepared_request prepared_request = make_prepared_request();
+    std::vector<int32_t> short_input { 1, 2, 3 };
+    std::vector<float> float_input { 1.0f, 2.0f, 3.0f, 4.0f };
+
+    EXPECT_THROW(prepared_request.set_input(0, std::span<const int32_t>(short_input)), std::runtime_error);
+    EXPECT_THROW(prepared_request.set_input(0, std::span<const float>(float_input)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(prepared_request.input_index("INPUT2")), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(tc::infer::tensor_converter().get_infer_request_buffer(prepared_request)), std::runtime_error);
+    EXPECT_THROW(tc::infer::prepared_request("echo", "1", { { "INPUT0", { 1, -1 }, tc::infer::data_type::Int32 } }), std::runtime_error);
+}
+
+TEST(prepared_request, infer)
+{
+    tc::infer::mock::mock_server server(tc::infer::tests::test_models());
+
+    // The stub client sends the arena message, the channel client the cached wire encoding
+    std::vector<std::unique_ptr<tc::infer::client_interface>> clients;
+    clients.push_back(tc::infer::tests::make_stub_client(server));
+    clients.push_back(std::make_unique<tc::infer::grpc_client>(std::vector<std::shared_ptr<grpc::ChannelInterface>>{ server.in_process_channel() }, tc::infer::client_options{}));
+
+    tc::infer::prepared_request prepared_request = make_prepared_request();
+    std::vector<int32_t> input0(4);
+    std::vector<float> input1 { 0.5f, -1.5f };
+    prepared_request.set_input(1, std::span<const float>(input1));
+
+    for (auto&& client : clients)
+    {
+        for (int32_t i = 0; i < 3; ++i)
+        {
+            std::iota(input0.begin(), input0.end(), i);
+            prepared_request.id = "request_" + std::to_string(i);
+            prepared_request.set_input(0, std::span<const int32_t>(input0));
+
+            const tc::infer::infer_response response = client->infer(prepared_request);
+            EXPECT_EQ(response.id, prepared_request.id);
+            ASSERT_EQ(response.output_tensors.size(), 2U);
+            EXPECT_EQ(response.output_tensors[0].data<int32_t>(), input0);
+            EXPECT_EQ(response.output_tensors[1].data<float>(), input1);
+        }
+    }
+
+}
+
+TEST(prepared_request, bytes_inputs_are_length_delimited)
+{
+    tc::infer::prepared_request prepared("model", "1", { { "INPUT0", { 2 }, tc::infer::data_type::String } });
+    const tc::infer::tensor_converter converter(true);
+    google::protobuf::Arena arena;
+
+    // Not null terminated: the elements are read within the bound byte size only
+    const std::vector<char> elements { 3, 0, 0, 0, 'a', 'b', 'c', 2, 0, 0, 0, 'd', 'e' };
+    prepared.set_input(0, std::span<const char>(elements));
+    const inference::ModelInferRequest* request = converter.get_infer_request(prepared, &arena);
+    EXPECT_EQ(request->raw_input_contents_size(), 0);
+    ASSERT_EQ(request->inputs(0).contents().bytes_contents_size(), 2);
+    EXPECT_EQ(request->inputs(0).contents().bytes_contents(0), "abc");
+    EXPECT_EQ(request->inputs(0).contents().bytes_contents(1), "de");
+
+    const std::vector<char> truncated { 3, 0, 0, 0, 'a', 'b', 'c', 5, 0, 0, 0, 'd', 'e' };
+    prepared.set_input(0, std::span<const char>(truncated));
+    EXPECT_THROW(converter.get_infer_request(prepared, &arena), tc::infer::invalid_request_error);
+
+    const std::vector<char> single_element { 3, 0, 0, 0, 'a', 'b', 'c' };
+    prepared.set_input(0, std::span<const char>(single_element));
+    EXPECT_THROW(converter.get_infer_request(prepared, &arena), tc::infer::invalid_request_error);
+}
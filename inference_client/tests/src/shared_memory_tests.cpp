@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "grpc_client.hpp"
+#include "tensor_converter.hpp"
+#include "test_models.hpp"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+class shared_memory_test : public testing::Test
+{
+protected:
+    static std::string unique_key(const std::string& name)
+    {
+        return "/tc_infer_test_" + name + "_" + std::to_string(::getpid());
+    }
+
+    tc::infer::mock::mock_server _server { tc::infer::tests::test_models() };
+    std::unique_ptr<tc::infer::client_interface> _client = tc::infer::tests::make_stub_client(_server);
+};
+
+}
+
+TEST_F(shared_memory_test, register_status_unregister)
+{
+    tc::infer::system_shared_memory_region region(unique_key("status"), 1024);
+
+    EXPECT_TRUE(_client->system_shared_memory_register("region", region.key(), region.byte_size()));
+    const auto status = _client->system_shared_memory_status("region");
+    ASSERT_EQ(status.size(), 1U);
+    EXPECT_EQ(status[0].name, "region");
+    EXPECT_EQ(status[0].key, region.key());
+    EXPECT_EQ(status[0].byte_size, 1024U);
+
+    EXPECT_THROW(_client->system_shared_memory_register("region", region.key(), region.byte_size()), std::runtime_error);
+
+    EXPECT_TRUE(_client->system_shared_memory_unregister("region"));
+    EXPECT_TRUE(_client->system_shared_memory_status().empty());
+}
+
+TEST_F(shared_memory_test, infer_with_shared_memory_input_and_output)
+{
+    const std::vector<int32_t> data { 1, 2, 3, 4, 5, 6, 7, 8 };
+    const size_t byte_size = data.size() * sizeof(int32_t);
+
+    tc::infer::system_shared_memory_region region(unique_key("infer"), 2 * byte_size);
+    std::memcpy(region.data(), data.data(), byte_size);
+    ASSERT_TRUE(_client->system_shared_memory_register("io", region.key(), region.byte_size()));
+
+    tc::infer::infer_request request;
+    request.model_name = "echo";
+    request.add_input_tensor_shared_memory({ "io", byte_size, 0 }, { 1, 8 }, tc::infer::data_type::Int32, "INPUT0");
+    request.add_requested_output_shared_memory("OUTPUT0", { "io", byte_size, byte_size });
+
+    const auto response = _client->infer(request);
+    ASSERT_EQ(response.output_tensors.size(), 1U);
+
+    const auto& output = response.output_tensors[0];
+    ASSERT_TRUE(output.shared_memory());
+    EXPECT_EQ(output.shared_memory()->region_name, "io");
+    EXPECT_EQ(output.shared_memory()->offset, byte_size);
+    EXPECT_EQ(output.shape(), (std::vector<int64_t>{ 1, 8 }));
+
+    std::vector<int32_t> output_data(data.size());
+    std::memcpy(output_data.data(), region.data() + byte_size, byte_size);
+    EXPECT_EQ(output_data, data);
+
+    _client->system_shared_memory_unregister();
+}
+
+TEST_F(shared_memory_test, shared_memory_tensors_only_send_metadata)
+{
+    tc::infer::infer_request request;
+    request.model_name = "echo";
+    request.add_input_tensor_shared_memory({ "io", 1 << 20, 64 }, { 1, 1 << 18 }, tc::infer::data_type::Fp32, "INPUT0");
+
+    std::vector<int32_t> data { 1, 2 };
+    request.add_input_tensor(data.data(), data.size(), { 1, 2 }, "INPUT1");
+    request.add_requested_output("OUTPUT0");
+
+    const auto message = tc::infer::tensor_converter().get_infer_request(request);
+    ASSERT_EQ(message.raw_input_contents_size(), 1);
+    EXPECT_EQ(message.raw_input_contents(0).size(), 2 * sizeof(int32_t));
+
+    const auto& parameters = message.inputs(0).parameters();
+    EXPECT_EQ(parameters.at("shared_memory_region").string_param(), "io");
+    EXPECT_EQ(parameters.at("shared_memory_byte_size").int64_param(), 1 << 20);
+    EXPECT_EQ(parameters.at("shared_memory_offset").int64_param(), 64);
+    EXPECT_TRUE(message.inputs(1).parameters().empty());
+
+    ASSERT_EQ(message.outputs_size(), 1);
+    EXPECT_EQ(message.outputs(0).name(), "OUTPUT0");
+    EXPECT_TRUE(message.outputs(0).parameters().empty());
+}
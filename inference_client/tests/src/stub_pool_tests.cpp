@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "grpc_client.hpp"
+#include "stub_pool.hpp"
+#include "test_models.hpp"
+
+#include <grpcpp/create_channel.h>
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> make_stubs(size_t num_stubs)
+{
+    // Channels connect lazily, the stubs are never used to send an RPC
+    std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs;
+    for (size_t i = 0; i < num_stubs; ++i)
+    {
+        stubs.push_back(inference::GRPCInferenceService::NewStub(grpc::CreateChannel("localhost:1", grpc::InsecureChannelCredentials())));
+    }
+    return stubs;
+}
+
+}
+
+TEST(stub_pool, round_robin)
+{
+    tc::infer::stub_pool pool(make_stubs(3), tc::infer::channel_selection::round_robin);
+
+    std::vector<tc::infer::stub_pool::lease> leases;
+    for (int i = 0; i < 6; ++i)
+    {
+        leases.push_back(pool.acquire());
+    }
+
+    EXPECT_EQ(leases[0].get(), leases[3].get());
+    EXPECT_NE(leases[0].get(), leases[1].get());
+    EXPECT_NE(leases[1].get(), leases[2].get());
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        EXPECT_EQ(pool.in_flight(i), 2);
+    }
+
+    leases.clear();
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        EXPECT_EQ(pool.in_flight(i), 0);
+    }
+}
+
+TEST(stub_pool, least_loaded)
+{
+    tc::infer::stub_pool pool(make_stubs(2), tc::infer::channel_selection::least_loaded);
+
+    auto busy = pool.acquire();
+    auto other = pool.acquire();
+    EXPECT_NE(busy.get(), other.get());
+
+    // Whatever the round robin position, the idle channel is selected while the other one has an RPC in flight
+    other.release();
+    for (int i = 0; i < 4; ++i)
+    {
+        auto lease = pool.acquire();
+        EXPECT_NE(lease.get(), busy.get());
+    }
+}
+
+TEST(stub_pool, client_with_multiple_channels)
+{
+    tc::infer::mock::mock_server server(tc::infer::tests::test_models());
+
+    std::vector<std::unique_ptr<inference::GRPCInferenceService::StubInterface>> stubs;
+    stubs.push_back(inference::GRPCInferenceService::NewStub(server.in_process_channel()));
+    stubs.push_back(inference::GRPCInferenceService::NewStub(server.in_process_channel()));
+    tc::infer::grpc_client client(std::move(stubs), tc::infer::client_options{ .channel_pool_size = 2 });
+
+    std::vector<int32_t> data { 1, 2, 3 };
+    for (int i = 0; i < 4; ++i)
+    {
+        tc::infer::infer_request request;
+        request.model_name = "echo";
+        request.add_input_tensor(data.data(), data.size(), { 1, 3 }, "INPUT0");
+        EXPECT_EQ(client.infer(request, std::chrono::seconds(1)).output_tensors[0].data<int32_t>(), data);
+    }
+    EXPECT_EQ(server.infer_count(), 4U);
+
+}
+
+TEST(stub_pool, client_with_generic_stubs)
+{
+    tc::infer::mock::mock_server server(tc::infer::tests::test_models());
+
+    // Clients created from channels send ModelInfer through the zero-copy serializer
+    std::vector<std::shared_ptr<grpc::ChannelInterface>> channels { server.in_process_channel() };
+    tc::infer::grpc_client client(channels, tc::infer::client_options{});
+
+    std::vector<int32_t> small { 1, 2, 3 };
+    std::vector<int32_t> large(256 * 1024);
+    std::iota(large.begin(), large.end(), 0);
+
+    tc::infer::infer_request request;
+    request.model_name = "echo";
+    request.add_input_tensor(small.data(), small.size(), { 1, 3 }, "INPUT0");
+    request.add_input_tensor_view(large.data(), large.size(), { 1, static_cast<int64_t>(large.size()) }, "INPUT1");
+
+    const auto response = client.infer(request, std::chrono::seconds(5));
+    ASSERT_EQ(response.output_tensors.size(), 2U);
+    EXPECT_EQ(response.output_tensors[0].data<int32_t>(), small);
+    EXPECT_EQ(response.output_tensors[1].data<int32_t>(), large);
+
+    request.model_name = "missing";
+    EXPECT_THROW(client.infer(request, std::chrono::seconds(5)), std::runtime_error);
+
+}
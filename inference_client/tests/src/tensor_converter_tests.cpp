@@ -0,0 +1,406 @@
+#include <gtest/gtest.h>
+#include "tensor_converter.hpp"
+#include "protobuf_arena.hpp"
+#include "simd_convert.hpp"
+
+#include <google/protobuf/util/message_differencer.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace
+{
+tc::infer::infer_request make_request()
+{
+    static std::vector<float> data_0 { 0.0f, 1.0f, 2.0f, 3.0f };
+    static std::vector<int32_t> data_1 { 4, 5, 6, 7 };
+
+    tc::infer::infer_request request;
+    request.model_name = "model";
+    request.model_version = "1";
+    request.add_input_tensor(data_0.data(), data_0.size(), { 1, 4 }, "INPUT0");
+    request.add_input_tensor(data_1.data(), data_1.size(), { 1, 4 }, "INPUT1");
+    return request;
+}
+
+std::string make_response_wire(const std::vector<int32_t>& output_0, const std::vector<float>& output_1)
+{
+    inference::ModelInferResponse response;
+    response.set_model_name("model");
+    response.set_id("id");
+
+    auto add_output = [&response](const std::string& name, const std::string& datatype, int64_t elements)
+    {
+        auto* output = response.add_outputs();
+        output->set_name(name);
+        output->set_datatype(datatype);
+        output->add_shape(1);
+        output->add_shape(elements);
+    };
+
+    add_output("OUTPUT0", "INT32", static_cast<int64_t>(output_0.size()));
+    add_output("OUTPUT1", "FP32", static_cast<int64_t>(output_1.size()));
+    response.add_raw_output_contents(output_0.data(), output_0.size() * sizeof(int32_t));
+    response.add_raw_output_contents(output_1.data(), output_1.size() * sizeof(float));
+    return response.SerializeAsString();
+}
+
+grpc::ByteBuffer make_byte_buffer(const std::string& wire, size_t slice_size)
+{
+    std::vector<grpc::Slice> slices;
+    for (size_t offset = 0; offset < wire.size(); offset += slice_size)
+    {
+        slices.emplace_back(wire.data() + offset, std::min(slice_size, wire.size() - offset));
+    }
+    return grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+// Server side of a typed response: the request writer fills the same InferTensorContents fields
+template<typename T>
+std::shared_ptr<const inference::ModelInferResponse> make_typed_response(const std::vector<T>& data)
+{
+    // std::vector<bool> has no data()
+    auto buffer = std::make_unique<T[]>(data.size());
+    std::copy(data.begin(), data.end(), buffer.get());
+
+    tc::infer::infer_request request;
+    request.add_input_tensor(buffer.get(), data.size(), { static_cast<int64_t>(data.size()) }, "OUTPUT0");
+    const auto typed_request = tc::infer::tensor_converter(false).get_infer_request(request);
+
+    auto response = std::make_shared<inference::ModelInferResponse>();
+    auto* output = response->add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype(typed_request.inputs(0).datatype());
+    output->mutable_shape()->CopyFrom(typed_request.inputs(0).shape());
+    output->mutable_contents()->CopyFrom(typed_request.inputs(0).contents());
+    return response;
+}
+
+template<typename T>
+void expect_typed_response(const std::vector<T>& data)
+{
+    const auto infer_response = tc::infer::tensor_converter().get_infer_response(make_typed_response(data));
+    ASSERT_EQ(infer_response.output_tensors.size(), 1U);
+
+    const auto& output = infer_response.output_tensors[0];
+    EXPECT_EQ(output.datatype(), tc::infer::cast_to_data_type<T>::type);
+    EXPECT_EQ(output.byte_size(), data.size() * sizeof(T));
+    EXPECT_EQ(output.template data<T>(), data);
+}
+
+}
+
+TEST(tensor_converter, raw_input_contents)
+{
+    tc::infer::tensor_converter converter(true);
+    const auto request = converter.get_infer_request(make_request());
+
+    ASSERT_EQ(request.inputs_size(), 2);
+    ASSERT_EQ(request.raw_input_contents_size(), 2);
+    EXPECT_FALSE(request.inputs(0).has_contents());
+    EXPECT_FALSE(request.inputs(1).has_contents());
+    EXPECT_EQ(request.inputs(0).datatype(), "FP32");
+    EXPECT_EQ(request.inputs(1).datatype(), "INT32");
+
+    const std::string& raw_0 = request.raw_input_contents(0);
+    ASSERT_EQ(raw_0.size(), 4 * sizeof(float));
+    float value = 0.0f;
+    std::memcpy(&value, raw_0.data() + 3 * sizeof(float), sizeof(float));
+    EXPECT_EQ(value, 3.0f);
+
+    const std::string& raw_1 = request.raw_input_contents(1);
+    ASSERT_EQ(raw_1.size(), 4 * sizeof(int32_t));
+    int32_t int_value = 0;
+    std::memcpy(&int_value, raw_1.data(), sizeof(int32_t));
+    EXPECT_EQ(int_value, 4);
+}
+
+TEST(tensor_converter, typed_input_contents)
+{
+    tc::infer::tensor_converter converter(false);
+    const auto request = converter.get_infer_request(make_request());
+
+    ASSERT_EQ(request.inputs_size(), 2);
+    EXPECT_EQ(request.raw_input_contents_size(), 0);
+    ASSERT_EQ(request.inputs(0).contents().fp32_contents_size(), 4);
+    EXPECT_EQ(request.inputs(0).contents().fp32_contents(3), 3.0f);
+    ASSERT_EQ(request.inputs(1).contents().int_contents_size(), 4);
+    EXPECT_EQ(request.inputs(1).contents().int_contents(0), 4);
+}
+
+TEST(tensor_converter, raw_input_contents_wire_size)
+{
+    std::vector<float> data(3 * 64 * 64, 1.5f);
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor(data.data(), data.size(), { 1, 3, 64, 64 }, "images");
+
+    const auto raw_request = tc::infer::tensor_converter(true).get_infer_request(infer_request);
+    const auto typed_request = tc::infer::tensor_converter(false).get_infer_request(infer_request);
+
+    EXPECT_GE(raw_request.ByteSizeLong(), data.size() * sizeof(float));
+    EXPECT_LE(raw_request.ByteSizeLong(), typed_request.ByteSizeLong());
+}
+
+TEST(tensor_converter, response_aliases_raw_output_contents)
+{
+    const std::vector<int32_t> output_data { 1, 2, 3, 4 };
+
+    auto response = std::make_shared<inference::ModelInferResponse>();
+    response->set_model_name("model");
+    auto* output = response->add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype("INT32");
+    output->add_shape(1);
+    output->add_shape(4);
+    response->add_raw_output_contents(output_data.data(), output_data.size() * sizeof(int32_t));
+    const char* raw_output = response->raw_output_contents(0).data();
+
+    auto infer_response = tc::infer::tensor_converter().get_infer_response(response);
+    response.reset();
+
+    ASSERT_EQ(infer_response.output_tensors.size(), 1U);
+    const auto& tensor = infer_response.output_tensors[0];
+    EXPECT_EQ(tensor.name(), "OUTPUT0");
+    EXPECT_EQ(tensor.datatype(), tc::infer::data_type::Int32);
+    EXPECT_EQ(tensor.byte_size(), output_data.size() * sizeof(int32_t));
+    EXPECT_EQ(static_cast<const void*>(tensor.raw_data()), static_cast<const void*>(raw_output));
+    EXPECT_EQ(tensor.data<int32_t>(), output_data);
+}
+
+TEST(tensor_converter, input_tensor_view_borrows_caller_memory)
+{
+    std::vector<float> frame(3 * 8 * 8, 0.25f);
+
+    tc::infer::infer_request infer_request;
+    infer_request.add_input_tensor_view(std::span<const float>(frame), { 1, 3, 8, 8 }, "images");
+
+    ASSERT_EQ(infer_request.input_tensors.size(), 1U);
+    const auto& input = infer_request.input_tensors[0];
+    EXPECT_EQ(static_cast<const void*>(input.raw_data()), static_cast<const void*>(frame.data()));
+    EXPECT_EQ(input.byte_size(), frame.size() * sizeof(float));
+    EXPECT_EQ(input.datatype(), tc::infer::data_type::Fp32);
+
+    const auto request = tc::infer::tensor_converter().get_infer_request(infer_request);
+    ASSERT_EQ(request.raw_input_contents_size(), 1);
+    EXPECT_EQ(request.raw_input_contents(0).size(), frame.size() * sizeof(float));
+}
+
+TEST(tensor_converter, arena_request)
+{
+    tc::infer::tensor_converter converter;
+    const auto heap_request = converter.get_infer_request(make_request());
+
+    tc::infer::thread_arena_scope arena_scope;
+    const inference::ModelInferRequest* arena_request = converter.get_infer_request(make_request(), arena_scope.arena());
+
+    EXPECT_EQ(arena_request->GetArena(), arena_scope.arena());
+    EXPECT_EQ(arena_request->SerializeAsString(), heap_request.SerializeAsString());
+}
+
+TEST(tensor_converter, arena_response_outlives_its_tensors_owner)
+{
+    std::vector<int32_t> data { 1, 2, 3 };
+    std::optional<tc::infer::infer_tensor> output;
+    {
+        auto response = tc::infer::make_arena_message<inference::ModelInferResponse>();
+        ASSERT_NE(response->GetArena(), nullptr);
+
+        auto* tensor = response->add_outputs();
+        tensor->set_name("OUTPUT0");
+        tensor->set_datatype("INT32");
+        tensor->add_shape(3);
+        response->add_raw_output_contents(data.data(), data.size() * sizeof(int32_t));
+
+        output = tc::infer::tensor_converter().get_infer_response(response).output_tensors.at(0);
+    }
+
+    ASSERT_TRUE(output);
+    EXPECT_EQ(output->data<int32_t>(), data);
+}
+
+TEST(tensor_converter, request_buffer_is_wire_compatible)
+{
+    std::vector<float> large(64 * 1024, 1.5f);
+    std::vector<int32_t> small { 1, 2, 3 };
+
+    tc::infer::infer_request infer_request;
+    infer_request.model_name = "model";
+    infer_request.id = "42";
+    infer_request.add_input_tensor_view(large.data(), large.size(), { 1, static_cast<int64_t>(large.size()) }, "LARGE");
+    infer_request.add_input_tensor(small.data(), small.size(), { 1, 3 }, "SMALL");
+    infer_request.add_input_tensor_shared_memory({ "region", 64, 0 }, { 1, 16 }, tc::infer::data_type::Fp32, "SHM");
+    infer_request.add_requested_output("OUTPUT0");
+
+    const tc::infer::tensor_converter converter;
+    const grpc::ByteBuffer buffer = converter.get_infer_request_buffer(infer_request);
+
+    std::vector<grpc::Slice> slices;
+    ASSERT_TRUE(buffer.Dump(&slices).ok());
+
+    std::string wire;
+    bool large_input_is_referenced = false;
+    for (const grpc::Slice& slice : slices)
+    {
+        wire.append(std::bit_cast<const char*>(slice.begin()), slice.size());
+        large_input_is_referenced |= std::bit_cast<const float*>(slice.begin()) == large.data();
+    }
+
+    EXPECT_TRUE(large_input_is_referenced);
+
+    // Map entries (the shared memory parameters) are not serialized in a deterministic order, so the messages are compared
+    inference::ModelInferRequest parsed;
+    ASSERT_TRUE(parsed.ParseFromString(wire));
+    EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(parsed, converter.get_infer_request(infer_request)));
+}
+
+TEST(tensor_converter, response_buffer_single_slice_is_not_copied)
+{
+    const std::vector<int32_t> output_0 { 1, 2, 3 };
+    const std::vector<float> output_1(1024, 0.5f);
+    grpc::ByteBuffer buffer = make_byte_buffer(make_response_wire(output_0, output_1), std::string::npos);
+
+    std::vector<grpc::Slice> slices;
+    ASSERT_TRUE(buffer.Dump(&slices).ok());
+    ASSERT_EQ(slices.size(), 1U);
+    const auto slice_begin = std::bit_cast<const std::byte*>(slices[0].begin());
+    const auto slice_end = slice_begin + slices[0].size();
+
+    const auto response = tc::infer::tensor_converter().get_infer_response(buffer);
+    EXPECT_EQ(response.model_name, "model");
+    EXPECT_EQ(response.id, "id");
+    ASSERT_EQ(response.output_tensors.size(), 2U);
+    EXPECT_EQ(response.output_tensors[0].data<int32_t>(), output_0);
+    EXPECT_EQ(response.output_tensors[1].data<float>(), output_1);
+    EXPECT_EQ(response.output_tensors[1].shape(), (std::vector<int64_t>{ 1, 1024 }));
+
+    for (const auto& output : response.output_tensors)
+    {
+        EXPECT_GE(output.raw_data(), slice_begin);
+        EXPECT_LE(output.raw_data() + output.byte_size(), slice_end);
+    }
+}
+
+TEST(tensor_converter, response_buffer_spanning_slices_is_gathered)
+{
+    const std::vector<int32_t> output_0 { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const std::vector<float> output_1(257, 2.5f);
+    const std::string wire = make_response_wire(output_0, output_1);
+
+    for (size_t slice_size : { size_t{ 1 }, size_t{ 3 }, size_t{ 64 } })
+    {
+        grpc::ByteBuffer buffer = make_byte_buffer(wire, slice_size);
+        const auto response = tc::infer::tensor_converter().get_infer_response(buffer);
+
+        EXPECT_EQ(response.model_name, "model");
+        ASSERT_EQ(response.output_tensors.size(), 2U);
+        EXPECT_EQ(response.output_tensors[0].data<int32_t>(), output_0);
+        EXPECT_EQ(response.output_tensors[1].data<float>(), output_1);
+    }
+}
+
+TEST(tensor_converter, response_buffer_truncated)
+{
+    const std::string wire = make_response_wire({ 1, 2, 3 }, { 1.0f });
+    grpc::ByteBuffer buffer = make_byte_buffer(wire.substr(0, wire.size() - 2), 16);
+    EXPECT_THROW(tc::infer::tensor_converter().get_infer_response(buffer), std::runtime_error);
+
+    // A raw_output_contents entry (field 6) declaring 1 TiB is rejected before anything is allocated for it
+    const std::string oversized = wire + std::string("\x32\x80\x80\x80\x80\x80\x20", 7) + "abc";
+    for (size_t slice_size : { size_t{16}, std::string::npos })
+    {
+        grpc::ByteBuffer oversized_buffer = make_byte_buffer(oversized, slice_size);
+        EXPECT_THROW(tc::infer::tensor_converter().get_infer_response(oversized_buffer), std::runtime_error);
+    }
+}
+
+TEST(tensor_converter, typed_output_contents)
+{
+    expect_typed_response<bool>({ true, false, false, true, true });
+    expect_typed_response<uint8_t>({ 0, 1, 127, 128, 255 });
+    expect_typed_response<uint16_t>({ 0, 1, 32767, 32768, 65535 });
+    expect_typed_response<uint32_t>({ 0, 1, 4294967295u });
+    expect_typed_response<uint64_t>({ 0, 1, 18446744073709551615u });
+    expect_typed_response<int8_t>({ -128, -1, 0, 1, 127 });
+    expect_typed_response<int16_t>({ -32768, -1, 0, 1, 32767 });
+    expect_typed_response<int32_t>({ -2147483647, -1, 0, 1, 2147483647 });
+    expect_typed_response<int64_t>({ -1, 0, 9223372036854775807 });
+    expect_typed_response<float>({ -1.5f, 0.0f, 3.25f });
+    expect_typed_response<double>({ -1.5, 0.0, 3.25 });
+}
+
+TEST(tensor_converter, typed_output_contents_string)
+{
+    auto response = std::make_shared<inference::ModelInferResponse>();
+    auto* output = response->add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype("BYTES");
+    output->add_shape(2);
+    output->mutable_contents()->add_bytes_contents("abc");
+    output->mutable_contents()->add_bytes_contents("de");
+
+    const auto infer_response = tc::infer::tensor_converter().get_infer_response(response);
+    ASSERT_EQ(infer_response.output_tensors.size(), 1U);
+    EXPECT_EQ(infer_response.output_tensors[0].datatype(), tc::infer::data_type::String);
+    EXPECT_EQ(infer_response.output_tensors[0].data<char>(), (std::vector<char>{ 3, 0, 0, 0, 'a', 'b', 'c', 2, 0, 0, 0, 'd', 'e' }));
+}
+
+TEST(tensor_converter, typed_output_contents_narrowing)
+{
+    // Lengths around the vector width exercise both the vectorized loop and the scalar tail
+    for (size_t size : { 0, 1, 7, 8, 15, 16, 17, 33, 1000 })
+    {
+        std::vector<uint32_t> source(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            source[i] = static_cast<uint32_t>(static_cast<int32_t>(i * 2654435761u) >> (i % 24));
+        }
+
+        std::vector<uint16_t> narrow_16(size);
+        std::vector<uint8_t> narrow_8(size);
+        tc::infer::simd::narrow_32_to_16(source.data(), size, narrow_16.data());
+        tc::infer::simd::narrow_32_to_8(source.data(), size, narrow_8.data());
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(narrow_16[i], static_cast<uint16_t>(source[i])) << "size " << size << " index " << i;
+            EXPECT_EQ(narrow_8[i], static_cast<uint8_t>(source[i])) << "size " << size << " index " << i;
+        }
+    }
+}
+
+TEST(tensor_converter, typed_input_contents_widening)
+{
+    for (size_t size : { 0, 1, 7, 8, 15, 16, 17, 33, 1000 })
+    {
+        std::vector<int8_t> int8_source(size);
+        std::vector<uint8_t> uint8_source(size);
+        std::vector<int16_t> int16_source(size);
+        std::vector<uint16_t> uint16_source(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            const auto value = static_cast<uint32_t>(i * 2654435761u);
+            int8_source[i] = static_cast<int8_t>(value);
+            uint8_source[i] = static_cast<uint8_t>(value);
+            int16_source[i] = static_cast<int16_t>(value);
+            uint16_source[i] = static_cast<uint16_t>(value);
+        }
+
+        std::vector<int32_t> int8_widened(size);
+        std::vector<uint32_t> uint8_widened(size);
+        std::vector<int32_t> int16_widened(size);
+        std::vector<uint32_t> uint16_widened(size);
+        tc::infer::simd::widen_to_32(int8_source.data(), size, int8_widened.data());
+        tc::infer::simd::widen_to_32(uint8_source.data(), size, uint8_widened.data());
+        tc::infer::simd::widen_to_32(int16_source.data(), size, int16_widened.data());
+        tc::infer::simd::widen_to_32(uint16_source.data(), size, uint16_widened.data());
+
+        EXPECT_EQ(int8_widened, std::vector<int32_t>(int8_source.begin(), int8_source.end())) << "size " << size;
+        EXPECT_EQ(uint8_widened, std::vector<uint32_t>(uint8_source.begin(), uint8_source.end())) << "size " << size;
+        EXPECT_EQ(int16_widened, std::vector<int32_t>(int16_source.begin(), int16_source.end())) << "size " << size;
+        EXPECT_EQ(uint16_widened, std::vector<uint32_t>(uint16_source.begin(), uint16_source.end())) << "size " << size;
+    }
+}
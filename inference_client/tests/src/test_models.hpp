@@ -0,0 +1,51 @@
+#pragma once
+
+#include <teiacare/inference_client/mock_server.hpp>
+#include "grpc_client.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tc::infer::tests
+{
+// Models served by the mock server to the client tests: "echo" declares INPUT0 as INT32 [1,-1], "slow" answers after 200ms
+// and "close" closes the streams with UNAVAILABLE. Any other model (e.g. "missing") fails with NOT_FOUND.
+inline tc::infer::mock::mock_server_options test_models()
+{
+    return tc::infer::mock::mock_server_options {
+        .models = {
+            { "echo", tc::infer::mock::model_kind::echo, tc::infer::data_type::Int32, { 1, -1 } },
+            { "slow", tc::infer::mock::model_kind::echo, tc::infer::data_type::Int32, { 1, -1 }, std::chrono::milliseconds(200) },
+            { "close", tc::infer::mock::model_kind::close_stream, tc::infer::data_type::Int32, { 1, -1 } },
+        },
+    };
+}
+
+// Client built on a stub of an in-process channel to the server (grpc_client or grpc_client_async)
+template<typename ClientT = tc::infer::grpc_client>
+std::unique_ptr<ClientT> make_stub_client(const tc::infer::mock::mock_server& server, const tc::infer::client_options& options = {})
+{
+    return std::make_unique<ClientT>(inference::GRPCInferenceService::NewStub(server.in_process_channel()), options);
+}
+
+// Request of a single INT32 input, of any shape and name to check the validation against the "echo" metadata
+inline tc::infer::infer_request make_int32_request(std::vector<int32_t> data, const std::vector<int64_t>& shape, const std::string& model_name = "echo", const std::string& input_name = "INPUT0", const std::string& id = "")
+{
+    tc::infer::infer_request request;
+    request.model_name = model_name;
+    request.model_version = "1";
+    request.id = id;
+    request.add_input_tensor(data.data(), data.size(), shape, input_name);
+    return request;
+}
+
+// Request of the "echo" INPUT0 with shape [1, data.size()]
+inline tc::infer::infer_request make_echo_request(std::vector<int32_t> data, const std::string& model_name = "echo", const std::string& id = "")
+{
+    const auto size = static_cast<int64_t>(data.size());
+    return make_int32_request(std::move(data), { 1, size }, model_name, "INPUT0", id);
+}
+
+}